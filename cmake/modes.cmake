@@ -25,3 +25,8 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+option(USE_MPI_PROFILER "Account MPI traffic of performance tests through PMPI" OFF)
+if(USE_MPI_PROFILER)
+  message(STATUS "Enable MPI profiler for performance tests")
+endif(USE_MPI_PROFILER)
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json_fwd.hpp"
+
+namespace ppc::performance {
+
+/// @brief Sustainable memory bandwidth of the STREAM kernels for one thread count.
+struct StreamResult {
+  /// @brief Number of OpenMP threads that ran the kernels.
+  int threads = 1;
+  /// @brief c = a, in GB/s.
+  double copy_gbs = 0.0;
+  /// @brief b = s * c, in GB/s.
+  double scale_gbs = 0.0;
+  /// @brief c = a + b, in GB/s.
+  double add_gbs = 0.0;
+  /// @brief a = b + s * c, in GB/s.
+  double triad_gbs = 0.0;
+};
+
+/// @brief MPI point-to-point performance for one message size.
+struct PingPongResult {
+  /// @brief Message size in bytes.
+  std::size_t bytes = 0;
+  /// @brief One-way latency in microseconds (half of the best round trip).
+  double latency_us = 0.0;
+  /// @brief One-way bandwidth in GB/s.
+  double bandwidth_gbs = 0.0;
+};
+
+/// @brief Measured ceilings of the machine used to normalize task benchmarks.
+struct Calibration {
+  /// @brief STREAM results in ascending thread count order.
+  std::vector<StreamResult> stream;
+  /// @brief Ping-pong results between ranks 0 and 1 in ascending message size order; empty for a single process.
+  std::vector<PingPongResult> ping_pong;
+
+  /// @brief Returns the triad bandwidth for the largest measured thread count not above @p threads, in GB/s.
+  /// @return 0 if nothing was measured.
+  [[nodiscard]] double PeakBandwidthGbs(int threads) const;
+};
+
+/// @brief Runs the STREAM copy, scale, add and triad kernels with @p threads OpenMP threads.
+/// @param threads Number of threads.
+/// @param elements Length of each of the three arrays; should exceed the last-level cache several times.
+/// @param repetitions Number of repetitions; the fastest one is reported.
+StreamResult MeasureStream(int threads, std::size_t elements, int repetitions);
+
+/// @brief Measures latency and bandwidth of blocking ping-pong between ranks 0 and 1 for every message size.
+/// @details Collective over MPI_COMM_WORLD; every process returns the timings of rank 0.
+/// @param sizes Message sizes in bytes.
+/// @return One result per size; empty if there is only one process.
+std::vector<PingPongResult> MeasurePingPong(const std::vector<std::size_t> &sizes);
+
+/// @brief Converts a calibration into JSON.
+nlohmann::json CalibrationToJson(const Calibration &calibration);
+
+/// @brief Restores a calibration from JSON produced by CalibrationToJson().
+/// @throws nlohmann::json::exception If a field is missing or has a wrong type.
+Calibration CalibrationFromJson(const nlohmann::json &json);
+
+/// @brief Returns the calibration of this job, measuring it on first use.
+/// @details Collective over MPI_COMM_WORLD on first call. STREAM runs for 1, 2, 4, ... up to @p max_threads threads
+/// and ping-pong for 8 B to 2 MiB messages. Rank 0 reads and writes the cache file in the temporary directory, keyed by
+/// host, number of processes and threads, and broadcasts the result, so later jobs on the same machine skip the
+/// measurement. Rank 0 runs STREAM while the other processes wait without polling, and ping-pong follows. Rank 0
+/// prints the result once per @p max_threads. Later calls of the same process with the same @p max_threads return the
+/// stored result without communication.
+/// @param max_threads Largest thread count to measure.
+const Calibration &GetCalibration(int max_threads);
+
+/// @brief Returns the path of the calibration cache file for the current machine and job shape.
+/// @param num_procs Number of MPI processes.
+/// @param max_threads Largest measured thread count.
+std::string GetCalibrationCachePath(int num_procs, int max_threads);
+
+}  // namespace ppc::performance
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ppc::performance {
+
+/// @brief Hardware events that Perf can count around Run().
+enum class HwCounter : uint8_t { kCycles, kInstructions, kCacheMisses, kBranchMisses, kLlcLoads };
+
+/// @brief Number of HwCounter values.
+constexpr std::size_t kHwCounterCount = 5;
+
+/// @brief Event counts indexed by HwCounter.
+using HwCounterValues = std::array<uint64_t, kHwCounterCount>;
+
+/// @brief Returns a snake_case name of the event.
+inline std::string_view GetHwCounterName(HwCounter counter) {
+  constexpr std::array<std::string_view, kHwCounterCount> kNames = {
+      "cycles",
+      "instructions",
+      "cache_misses",
+      "branch_misses",
+      "llc_loads",
+  };
+  return kNames.at(static_cast<std::size_t>(counter));
+}
+
+/// @brief Set of hardware performance counters of the calling process backed by perf_event_open on Linux.
+/// @details Counts user-space events of the opening thread and of threads it creates afterwards. Counters that the
+/// kernel refuses (perf_event_paranoid, containers, virtual machines, other platforms) stay unavailable and read as 0.
+class HwCounterGroup {
+ public:
+  HwCounterGroup();
+  ~HwCounterGroup();
+  HwCounterGroup(const HwCounterGroup &) = delete;
+  HwCounterGroup &operator=(const HwCounterGroup &) = delete;
+  HwCounterGroup(HwCounterGroup &&) = delete;
+  HwCounterGroup &operator=(HwCounterGroup &&) = delete;
+
+  /// @brief Opens every counter in the disabled state.
+  /// @return True if at least one counter is available.
+  bool Open();
+  /// @brief Releases all counters.
+  void Close();
+  /// @brief Checks whether @p counter was opened successfully.
+  [[nodiscard]] bool IsAvailable(HwCounter counter) const;
+  /// @brief Zeroes all counters.
+  void Reset();
+  /// @brief Starts counting.
+  void Enable();
+  /// @brief Stops counting.
+  void Disable();
+  /// @brief Reads the counters, scaled up if the kernel had to multiplex them.
+  [[nodiscard]] HwCounterValues Read() const;
+
+ private:
+  std::array<int, kHwCounterCount> fds_{};
+};
+
+}  // namespace ppc::performance
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace ppc::performance {
+
+/// @brief MPI routines accounted by the optional PMPI profiling layer.
+enum class MpiRoutine : uint8_t {
+  kSend,
+  kRecv,
+  kIsend,
+  kIrecv,
+  kSendrecv,
+  kWait,
+  kWaitall,
+  kBcast,
+  kScatter,
+  kScatterv,
+  kIscatterv,
+  kGather,
+  kGatherv,
+  kAllgather,
+  kAllgatherv,
+  kReduce,
+  kAllreduce,
+  kBarrier,
+};
+
+/// @brief Number of MpiRoutine values.
+constexpr std::size_t kMpiRoutineCount = 18;
+
+/// @brief Returns the MPI name of the routine, e.g. "MPI_Bcast".
+inline std::string_view GetMpiRoutineName(MpiRoutine routine) {
+  constexpr std::array<std::string_view, kMpiRoutineCount> kNames = {
+      "MPI_Send",
+      "MPI_Recv",
+      "MPI_Isend",
+      "MPI_Irecv",
+      "MPI_Sendrecv",
+      "MPI_Wait",
+      "MPI_Waitall",
+      "MPI_Bcast",
+      "MPI_Scatter",
+      "MPI_Scatterv",
+      "MPI_Iscatterv",
+      "MPI_Gather",
+      "MPI_Gatherv",
+      "MPI_Allgather",
+      "MPI_Allgatherv",
+      "MPI_Reduce",
+      "MPI_Allreduce",
+      "MPI_Barrier",
+  };
+  return kNames.at(static_cast<std::size_t>(routine));
+}
+
+/// @brief Traffic accounted for one MPI routine.
+struct MpiRoutineStats {
+  /// @brief Number of calls.
+  uint64_t calls = 0;
+  /// @brief Payload bytes sent and received by the calling process.
+  uint64_t bytes = 0;
+  /// @brief Time spent inside the routine in seconds.
+  double time_sec = 0.0;
+};
+
+/// @brief MPI traffic of one process indexed by pipeline stage and routine.
+using MpiProfileTable = std::array<std::array<MpiRoutineStats, kMpiRoutineCount>, ppc::util::kActiveStageCount>;
+
+/// @brief Process-wide storage filled by the PMPI profiling layer.
+/// @details The layer is linked into ppc_perf_tests with -D USE_MPI_PROFILER=ON. Without it the table stays empty
+///          and IsEnabled() returns false. Calls are expected from a single thread per process.
+class MpiProfile {
+ public:
+  /// @brief Called once by the PMPI layer when it is linked in.
+  static void Enable() {
+    enabled.store(true);
+  }
+
+  /// @brief Checks whether MPI calls of this process are being accounted.
+  static bool IsEnabled() {
+    return enabled.load();
+  }
+
+  /// @brief Accounts one call of @p routine in the currently active pipeline stage.
+  static void Record(MpiRoutine routine, uint64_t bytes, double time_sec) {
+    const auto stage = static_cast<std::size_t>(ppc::util::ActiveStageTracker::Get());
+    auto &stats = table[stage][static_cast<std::size_t>(routine)];
+    stats.calls++;
+    stats.bytes += bytes;
+    stats.time_sec += time_sec;
+  }
+
+  /// @brief Drops everything accounted so far.
+  static void Reset() {
+    table = {};
+  }
+
+  /// @brief Returns the traffic accounted since the last Reset().
+  static const MpiProfileTable &GetTable() {
+    return table;
+  }
+
+ private:
+  inline static std::atomic<bool> enabled{false};
+  inline static MpiProfileTable table{};
+};
+
+/// @brief Gathers the MPI profile of every process to rank 0.
+/// @details Collective over MPI_COMM_WORLD. Uses PMPI entry points so the gather itself is not accounted.
+/// @param local Profile of the calling process.
+/// @return Profiles indexed by rank on rank 0, an empty vector elsewhere.
+std::vector<MpiProfileTable> GatherMpiProfiles(const MpiProfileTable &local);
+
+}  // namespace ppc::performance
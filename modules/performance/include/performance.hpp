@@ -1,14 +1,25 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/mpi_profile.hpp"
+#include "performance/include/regression.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
 
@@ -21,20 +32,248 @@ inline double DefaultTimer() {
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
   uint64_t num_running = 5;
+  /// @brief Number of untimed runs before measurement (cold caches, page faults, thread pools, MPI connections).
+  uint64_t num_warmup = 1;
+  /// @brief Keep running until the median is stable instead of doing exactly num_running runs.
+  bool adaptive = false;
+  /// @brief Adaptive mode: stop once the relative 95% confidence interval of the median is below this value.
+  double target_rel_ci = 0.05;
+  /// @brief Adaptive mode: minimal number of measured runs.
+  uint64_t min_running = 5;
+  /// @brief Adaptive mode: maximal number of measured runs.
+  uint64_t max_running = 1000;
+  /// @brief Adaptive mode: wall-time budget for the measured runs in seconds.
+  double max_time_sec = 5.0;
+  /// @brief Count hardware events around Run() in every measured iteration.
+  bool hw_counters = false;
+  /// @brief Problem size reported with the results and used to normalize hardware events; 0 takes the operations
+  /// reported by Task::GetWorkUnits().
+  uint64_t num_elements = 0;
+  /// @brief Memory bandwidth ceiling of the machine in GB/s for the percent-of-peak report; 0 if unknown.
+  double peak_bandwidth_gbs = 0.0;
+  /// @brief Combines the local stop decision of adaptive mode across processes.
+  /// @details All processes must take the same decision, otherwise collective calls inside Run() deadlock.
+  /// @cond
+  std::function<bool(bool)> sync_decision = [](bool decision) { return decision; };
+  /// @endcond
   /// @brief Timer function returning current time in seconds.
   /// @cond
   std::function<double()> current_timer = DefaultTimer;
   /// @endcond
 };
 
+/// @brief Spread of one timing metric across MPI processes.
+struct RankSpread {
+  /// @brief Fastest process time in seconds.
+  double min_sec = 0.0;
+  /// @brief Mean process time in seconds.
+  double mean_sec = 0.0;
+  /// @brief Slowest process time in seconds.
+  double max_sec = 0.0;
+  /// @brief Ratio of the slowest to the mean process time; 1 means perfect balance.
+  double imbalance = 1.0;
+  /// @brief Rank of the slowest process.
+  int slowest_rank = 0;
+};
+
+/// @brief Cross-process view of the mean iteration time and of every pipeline stage.
+struct RankImbalance {
+  /// @brief Number of processes that contributed; 0 if nothing was gathered.
+  int num_ranks = 0;
+  RankSpread total;
+  RankSpread validation;
+  RankSpread preprocessing;
+  RankSpread run;
+  RankSpread postprocessing;
+};
+
+/// @brief Hardware events counted around Run(), averaged over the measured iterations.
+struct HwCounterStats {
+  /// @brief Whether counting was requested through PerfAttr::hw_counters.
+  bool requested = false;
+  /// @brief Counters the kernel allowed to open; unavailable ones are left at 0.
+  std::array<bool, kHwCounterCount> available{};
+  /// @brief Mean count of every event per iteration, indexed by HwCounter.
+  std::array<double, kHwCounterCount> mean{};
+};
+
 struct PerfResults {
-  /// @brief Measured execution time in seconds.
+  /// @brief Mean execution time of one iteration in seconds.
   double time_sec = 0.0;
+  /// @brief Fastest iteration in seconds.
+  double min_sec = 0.0;
+  /// @brief Median iteration time in seconds.
+  double median_sec = 0.0;
+  /// @brief 90th percentile of iteration times in seconds.
+  double p90_sec = 0.0;
+  /// @brief 99th percentile of iteration times in seconds.
+  double p99_sec = 0.0;
+  /// @brief Slowest iteration in seconds.
+  double max_sec = 0.0;
+  /// @brief Sample standard deviation of iteration times in seconds.
+  double stddev_sec = 0.0;
+  /// @brief Width of the 95% confidence interval of the median relative to the median.
+  double median_rel_ci = 0.0;
+  /// @brief Raw per-iteration execution times in seconds, in the order they were measured.
+  std::vector<double> samples_sec;
+  /// @brief Per-iteration time of each pipeline stage, parallel to samples_sec.
+  /// @details In task run mode only run_sec is measured.
+  std::vector<ppc::task::StageTimes> stage_samples;
+  /// @brief Mean time of each pipeline stage over stage_samples.
+  ppc::task::StageTimes stage_mean;
+  /// @brief Per-iteration hardware event counts around Run(), parallel to samples_sec; empty unless requested.
+  std::vector<HwCounterValues> hw_samples;
+  /// @brief Mean hardware event counts over hw_samples.
+  HwCounterStats hw_counters;
+  /// @brief Problem size copied from PerfAttr::num_elements; 0 if unknown.
+  uint64_t num_elements = 0;
+  /// @brief Work done by one Run() as reported by Task::GetWorkUnits().
+  ppc::task::WorkUnits work_units;
+  /// @brief Bytes read and written per second of Run() time, in GB/s.
+  double bandwidth_gbs = 0.0;
+  /// @brief Operations per second of Run() time.
+  double elements_per_sec = 0.0;
+  /// @brief Memory bandwidth ceiling copied from PerfAttr::peak_bandwidth_gbs; 0 if unknown.
+  double peak_bandwidth_gbs = 0.0;
+  /// @brief Spread of the timings across MPI processes, filled on rank 0 by GatherRankImbalance().
+  RankImbalance rank_imbalance;
+  /// @brief MPI traffic of this process during the measured runs; empty unless the PMPI layer is linked.
+  MpiProfileTable mpi_profile{};
+  /// @brief MPI traffic of every process indexed by rank, filled on rank 0 by Perf::CollectMpiProfiles().
+  std::vector<MpiProfileTable> rank_mpi_profiles;
   enum class TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone };
   TypeOfRunning type_of_running = TypeOfRunning::kNone;
   constexpr static double kMaxTime = 10.0;
 };
 
+/// @brief Returns the q-th quantile of sorted samples using linear interpolation between closest ranks.
+/// @param sorted Samples in ascending order.
+/// @param q Quantile in range [0, 1].
+/// @return Interpolated quantile, or 0 if there are no samples.
+inline double Quantile(const std::vector<double> &sorted, double q) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const double pos = std::clamp(q, 0.0, 1.0) * static_cast<double>(sorted.size() - 1);
+  const auto lower = static_cast<std::size_t>(std::floor(pos));
+  const auto upper = std::min(lower + 1, sorted.size() - 1);
+  const double frac = pos - static_cast<double>(lower);
+  return sorted[lower] + ((sorted[upper] - sorted[lower]) * frac);
+}
+
+/// @brief Summarizes one metric measured on every process.
+/// @param per_rank Values indexed by rank.
+/// @return Minimum, mean, maximum, imbalance ratio and the slowest rank.
+inline RankSpread ComputeRankSpread(const std::vector<double> &per_rank) {
+  RankSpread spread;
+  if (per_rank.empty()) {
+    return spread;
+  }
+  const auto max_it = std::ranges::max_element(per_rank);
+  spread.min_sec = std::ranges::min(per_rank);
+  spread.max_sec = *max_it;
+  spread.slowest_rank = static_cast<int>(std::distance(per_rank.begin(), max_it));
+  spread.mean_sec = std::accumulate(per_rank.begin(), per_rank.end(), 0.0) / static_cast<double>(per_rank.size());
+  spread.imbalance = spread.mean_sec > 0.0 ? spread.max_sec / spread.mean_sec : 1.0;
+  return spread;
+}
+
+/// @brief Gathers the mean iteration time and stage means of every process to rank 0.
+/// @details Collective over MPI_COMM_WORLD; the returned value is only meaningful on rank 0.
+/// @param local Results measured on the calling process.
+/// @return Cross-process spread of every timing.
+RankImbalance GatherRankImbalance(const PerfResults &local);
+
+/// @brief Returns the width of the distribution-free 95% confidence interval of the median relative to the median.
+/// @details The interval bounds are order statistics, so no assumption about the time distribution is made.
+/// @param sorted Samples in ascending order.
+/// @return Relative interval width, or infinity if it cannot be estimated yet.
+inline double MedianRelativeCI(const std::vector<double> &sorted) {
+  const auto n = sorted.size();
+  if (n < 2) {
+    return std::numeric_limits<double>::infinity();
+  }
+  constexpr double kZ95 = 1.96;
+  const double center = static_cast<double>(n) / 2.0;
+  const double half_width = kZ95 * std::sqrt(static_cast<double>(n)) / 2.0;
+  const auto lower = static_cast<std::size_t>(std::max(0.0, std::floor(center - half_width)));
+  const auto upper = std::min(n - 1, static_cast<std::size_t>(std::ceil(center + half_width)));
+  const double width = sorted[upper] - sorted[lower];
+  if (width <= 0.0) {
+    return 0.0;
+  }
+  const double median = Quantile(sorted, 0.5);
+  return median > 0.0 ? width / median : std::numeric_limits<double>::infinity();
+}
+
+/// @brief Fills the distribution statistics of @p perf_results from its raw samples.
+/// @param perf_results Results whose samples_sec are already collected.
+inline void ComputeStatistics(PerfResults &perf_results) {
+  const auto &samples = perf_results.samples_sec;
+  if (samples.empty()) {
+    return;
+  }
+  std::vector<double> sorted(samples);
+  std::ranges::sort(sorted);
+
+  const auto count = static_cast<double>(samples.size());
+  const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+  double sq_sum = 0.0;
+  for (const double sample : samples) {
+    sq_sum += (sample - mean) * (sample - mean);
+  }
+
+  perf_results.time_sec = mean;
+  perf_results.min_sec = sorted.front();
+  perf_results.median_sec = Quantile(sorted, 0.5);
+  perf_results.p90_sec = Quantile(sorted, 0.9);
+  perf_results.p99_sec = Quantile(sorted, 0.99);
+  perf_results.max_sec = sorted.back();
+  perf_results.stddev_sec = samples.size() > 1 ? std::sqrt(sq_sum / (count - 1.0)) : 0.0;
+  perf_results.median_rel_ci = samples.size() > 1 ? MedianRelativeCI(sorted) : 0.0;
+
+  perf_results.stage_mean = {};
+  for (const auto &stage : perf_results.stage_samples) {
+    perf_results.stage_mean.validation_sec += stage.validation_sec;
+    perf_results.stage_mean.preprocessing_sec += stage.preprocessing_sec;
+    perf_results.stage_mean.run_sec += stage.run_sec;
+    perf_results.stage_mean.postprocessing_sec += stage.postprocessing_sec;
+  }
+  if (!perf_results.stage_samples.empty()) {
+    const auto stage_count = static_cast<double>(perf_results.stage_samples.size());
+    perf_results.stage_mean.validation_sec /= stage_count;
+    perf_results.stage_mean.preprocessing_sec /= stage_count;
+    perf_results.stage_mean.run_sec /= stage_count;
+    perf_results.stage_mean.postprocessing_sec /= stage_count;
+  }
+
+  perf_results.hw_counters.mean = {};
+  for (const auto &hw_sample : perf_results.hw_samples) {
+    for (std::size_t i = 0; i < kHwCounterCount; i++) {
+      perf_results.hw_counters.mean[i] += static_cast<double>(hw_sample[i]);
+    }
+  }
+  if (!perf_results.hw_samples.empty()) {
+    for (auto &mean_count : perf_results.hw_counters.mean) {
+      mean_count /= static_cast<double>(perf_results.hw_samples.size());
+    }
+  }
+}
+
+/// @brief Derives bandwidth and element throughput of @p perf_results from its work units and mean Run() time.
+/// @param perf_results Results with work_units and stage statistics already filled.
+inline void ComputeThroughput(PerfResults &perf_results) {
+  const double run_sec = perf_results.stage_mean.run_sec;
+  perf_results.bandwidth_gbs = 0.0;
+  perf_results.elements_per_sec = 0.0;
+  if (run_sec <= 0.0) {
+    return;
+  }
+  const auto &work = perf_results.work_units;
+  perf_results.bandwidth_gbs = static_cast<double>(work.bytes_read + work.bytes_written) / run_sec * 1e-9;
+  perf_results.elements_per_sec = static_cast<double>(work.operations) / run_sec;
+}
+
 template <typename InType, typename OutType>
 class Perf {
  public:
@@ -50,9 +289,10 @@ class Perf {
     CommonRun(perf_attr, [&] {
       task_->Validation();
       task_->PreProcessing();
-      task_->Run();
+      CountedRun();
       task_->PostProcessing();
-    }, perf_results_);
+    }, [&] { return task_->GetStageTimes(); }, hw_counters_, perf_results_);
+    CollectWorkUnits();
   }
   // Check performance of task's Run() function
   void TaskRun(const PerfAttr &perf_attr) {
@@ -60,7 +300,10 @@ class Perf {
 
     task_->Validation();
     task_->PreProcessing();
-    CommonRun(perf_attr, [&] { task_->Run(); }, perf_results_);
+    CommonRun(perf_attr, [&] { CountedRun(); }, [&] {
+      return ppc::task::StageTimes{.run_sec = task_->GetStageTimes().run_sec};
+    }, hw_counters_, perf_results_);
+    CollectWorkUnits();
     task_->PostProcessing();
 
     task_->Validation();
@@ -87,6 +330,8 @@ class Perf {
     if (time_secs < max_time) {
       perf_res_str << std::fixed << std::setprecision(10) << time_secs;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintDistribution(test_id, type_test_name);
+      CheckBaseline(test_id, type_test_name);
     } else {
       std::stringstream err_msg;
       err_msg << '\n' << "Task execute time need to be: ";
@@ -94,9 +339,22 @@ class Perf {
       err_msg << "Original time in secs: " << time_secs << '\n';
       perf_res_str << std::fixed << std::setprecision(10) << -1.0;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintDistribution(test_id, type_test_name);
       throw std::runtime_error(err_msg.str().c_str());
     }
   }
+  /// @brief Collects the timings of all MPI processes on rank 0 for the load-imbalance report.
+  /// @note Must be called by every process.
+  void CollectRankImbalance() {
+    perf_results_.rank_imbalance = GatherRankImbalance(perf_results_);
+  }
+  /// @brief Collects the MPI traffic of all processes on rank 0 if the PMPI profiling layer is linked.
+  /// @note Must be called by every process.
+  void CollectMpiProfiles() {
+    if (MpiProfile::IsEnabled()) {
+      perf_results_.rank_mpi_profiles = GatherMpiProfiles(perf_results_.mpi_profile);
+    }
+  }
   /// @brief Retrieves the performance test results.
   /// @return The latest PerfResults structure.
   [[nodiscard]] PerfResults GetPerfResults() const {
@@ -106,13 +364,212 @@ class Perf {
  private:
   PerfResults perf_results_;
   std::shared_ptr<ppc::task::Task<InType, OutType>> task_;
-  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
-    auto begin = perf_attr.current_timer();
-    for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+  HwCounterGroup hw_counters_;
+  // Take the work units of the task for throughput metrics and the problem size if it was not given
+  void CollectWorkUnits() {
+    perf_results_.work_units = task_->GetWorkUnits();
+    if (perf_results_.num_elements == 0) {
+      perf_results_.num_elements = perf_results_.work_units.operations;
+    }
+    ComputeThroughput(perf_results_);
+  }
+  // Run() with hardware counting around it; counting is a no-op unless the counters are open
+  void CountedRun() {
+    hw_counters_.Enable();
+    task_->Run();
+    hw_counters_.Disable();
+  }
+  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline,
+                        const std::function<ppc::task::StageTimes()> &stage_times, HwCounterGroup &hw_counters,
+                        PerfResults &perf_results) {
+    perf_results.num_elements = perf_attr.num_elements;
+    perf_results.peak_bandwidth_gbs = perf_attr.peak_bandwidth_gbs;
+    perf_results.hw_counters = {.requested = perf_attr.hw_counters};
+    // Opened before the warm-ups so that worker threads they spawn inherit the counters
+    if (perf_attr.hw_counters) {
+      hw_counters.Open();
+      for (std::size_t i = 0; i < kHwCounterCount; i++) {
+        perf_results.hw_counters.available[i] = hw_counters.IsAvailable(static_cast<HwCounter>(i));
+      }
+    }
+    for (uint64_t i = 0; i < perf_attr.num_warmup; i++) {
+      pipeline();
+    }
+
+    const uint64_t max_running =
+        perf_attr.adaptive ? std::max(perf_attr.min_running, perf_attr.max_running) : perf_attr.num_running;
+    const auto expected_running = perf_attr.adaptive ? perf_attr.min_running : perf_attr.num_running;
+    perf_results.samples_sec.clear();
+    perf_results.samples_sec.reserve(expected_running);
+    perf_results.stage_samples.clear();
+    perf_results.stage_samples.reserve(expected_running);
+    perf_results.hw_samples.clear();
+    MpiProfile::Reset();
+    const double start = perf_attr.adaptive ? perf_attr.current_timer() : 0.0;
+    for (uint64_t i = 0; i < max_running; i++) {
+      hw_counters.Reset();
+      auto begin = perf_attr.current_timer();
       pipeline();
+      auto end = perf_attr.current_timer();
+      perf_results.samples_sec.push_back(end - begin);
+      perf_results.stage_samples.push_back(stage_times());
+      if (perf_attr.hw_counters) {
+        perf_results.hw_samples.push_back(hw_counters.Read());
+      }
+
+      if (perf_attr.adaptive && i + 1 >= perf_attr.min_running &&
+          perf_attr.sync_decision(IsStable(perf_attr, perf_results, end - start))) {
+        break;
+      }
+    }
+    hw_counters.Close();
+    perf_results.mpi_profile = MpiProfile::GetTable();
+    ComputeStatistics(perf_results);
+  }
+  // Adaptive mode stop criterion: the median is precise enough or the time budget is spent
+  static bool IsStable(const PerfAttr &perf_attr, const PerfResults &perf_results, double elapsed) {
+    if (elapsed >= perf_attr.max_time_sec) {
+      return true;
+    }
+    std::vector<double> sorted(perf_results.samples_sec);
+    std::ranges::sort(sorted);
+    return MedianRelativeCI(sorted) <= perf_attr.target_rel_ci;
+  }
+  // Compare the samples with the stored baseline if PPC_PERF_BASELINE_FILE is set and fail on a significant slowdown
+  void CheckBaseline(const std::string &test_id, const std::string &type_test_name) const {
+    const auto baseline_file = ppc::util::GetPerfBaselineFile();
+    if (baseline_file.empty()) {
+      return;
+    }
+    const RegressionCriteria criteria{.margin = ppc::util::GetPerfRegressionMargin()};
+    const auto verdict = CompareWithBaseline(perf_results_.samples_sec,
+                                             LoadBaselineSamples(baseline_file, test_id, type_test_name), criteria);
+    if (!verdict.has_baseline) {
+      std::cout << test_id << ":" << type_test_name << ":baseline:missing" << '\n';
+      return;
+    }
+    std::stringstream baseline_str;
+    baseline_str << std::fixed << std::setprecision(10) << "median=" << perf_results_.median_sec
+                 << ",baseline_median=" << verdict.baseline_median_sec << ",ratio=" << verdict.ratio
+                 << ",p=" << verdict.p_value << ",margin=" << criteria.margin << ",regressed=" << verdict.regressed;
+    std::cout << test_id << ":" << type_test_name << ":baseline:" << baseline_str.str() << '\n';
+    if (verdict.regressed) {
+      std::stringstream err_msg;
+      err_msg << '\n' << "Task is significantly slower than the baseline: ";
+      err_msg << "median time ratio " << verdict.ratio << " exceeds 1 + " << criteria.margin << " (p = ";
+      err_msg << verdict.p_value << " < " << criteria.alpha << ")." << '\n';
+      throw std::runtime_error(err_msg.str().c_str());
+    }
+  }
+  // Print the bandwidth and element rate of Run() if the task reports its work units
+  void PrintThroughput(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &work = perf_results_.work_units;
+    if (work.bytes_read == 0 && work.bytes_written == 0 && work.operations == 0) {
+      return;
+    }
+    std::stringstream throughput_str;
+    throughput_str << std::fixed << std::setprecision(4) << "bytes_read=" << work.bytes_read
+                   << ",bytes_written=" << work.bytes_written << ",operations=" << work.operations
+                   << ",gbs=" << perf_results_.bandwidth_gbs << ",elements_per_sec=" << perf_results_.elements_per_sec;
+    if (perf_results_.peak_bandwidth_gbs > 0.0) {
+      throughput_str << ",peak_gbs=" << perf_results_.peak_bandwidth_gbs
+                     << ",peak_pct=" << 100.0 * perf_results_.bandwidth_gbs / perf_results_.peak_bandwidth_gbs;
+    }
+    std::cout << test_id << ":" << type_test_name << ":throughput:" << throughput_str.str() << '\n';
+  }
+  // Print mean hardware events per iteration with IPC and, if the problem size is known, misses per element
+  void PrintHwCounters(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &hw = perf_results_.hw_counters;
+    if (!hw.requested) {
+      return;
+    }
+    const auto available = [&hw](HwCounter counter) { return hw.available[static_cast<std::size_t>(counter)]; };
+    const auto mean = [&hw](HwCounter counter) { return hw.mean[static_cast<std::size_t>(counter)]; };
+    std::stringstream hw_str;
+    hw_str << std::fixed << std::setprecision(4);
+    std::string separator;
+    for (std::size_t i = 0; i < kHwCounterCount; i++) {
+      const auto counter = static_cast<HwCounter>(i);
+      if (available(counter)) {
+        hw_str << separator << GetHwCounterName(counter) << "=" << mean(counter);
+        separator = ",";
+      }
+    }
+    if (separator.empty()) {
+      std::cout << test_id << ":" << type_test_name << ":hw:unavailable" << '\n';
+      return;
+    }
+    if (available(HwCounter::kCycles) && available(HwCounter::kInstructions) && mean(HwCounter::kCycles) > 0.0) {
+      hw_str << ",ipc=" << mean(HwCounter::kInstructions) / mean(HwCounter::kCycles);
+    }
+    if (perf_results_.num_elements > 0) {
+      const auto elements = static_cast<double>(perf_results_.num_elements);
+      for (const auto counter : {HwCounter::kCacheMisses, HwCounter::kBranchMisses, HwCounter::kLlcLoads}) {
+        if (available(counter)) {
+          hw_str << "," << GetHwCounterName(counter) << "_per_elem=" << mean(counter) / elements;
+        }
+      }
+    }
+    std::cout << test_id << ":" << type_test_name << ":hw:" << hw_str.str() << '\n';
+  }
+  // Print the MPI traffic of every rank, one line per rank
+  void PrintMpiProfiles(const std::string &test_id, const std::string &type_test_name) const {
+    for (std::size_t rank = 0; rank < perf_results_.rank_mpi_profiles.size(); rank++) {
+      std::stringstream mpi_str;
+      mpi_str << std::fixed << std::setprecision(10) << "rank=" << rank;
+      const auto &profile = perf_results_.rank_mpi_profiles[rank];
+      for (std::size_t stage = 0; stage < profile.size(); stage++) {
+        for (std::size_t routine = 0; routine < profile[stage].size(); routine++) {
+          const auto &stats = profile[stage][routine];
+          if (stats.calls == 0) {
+            continue;
+          }
+          mpi_str << ";" << ppc::util::GetActiveStageName(static_cast<ppc::util::ActiveStage>(stage)) << "."
+                  << GetMpiRoutineName(static_cast<MpiRoutine>(routine)) << ":calls=" << stats.calls
+                  << ",bytes=" << stats.bytes << ",time=" << stats.time_sec;
+        }
+      }
+      std::cout << test_id << ":" << type_test_name << ":mpi:" << mpi_str.str() << '\n';
+    }
+  }
+  // Print the time distribution, per-stage means, throughput, hardware events, MPI traffic and rank spread in lines
+  // the time scrapers ignore
+  void PrintDistribution(const std::string &test_id, const std::string &type_test_name) const {
+    std::stringstream stats_str;
+    stats_str << std::fixed << std::setprecision(10) << "min=" << perf_results_.min_sec
+              << ",median=" << perf_results_.median_sec << ",p90=" << perf_results_.p90_sec
+              << ",p99=" << perf_results_.p99_sec << ",max=" << perf_results_.max_sec
+              << ",stddev=" << perf_results_.stddev_sec << ",rel_ci=" << perf_results_.median_rel_ci
+              << ",n=" << perf_results_.samples_sec.size();
+    std::cout << test_id << ":" << type_test_name << ":stats:" << stats_str.str() << '\n';
+
+    const auto &stage = perf_results_.stage_mean;
+    std::stringstream stages_str;
+    stages_str << std::fixed << std::setprecision(10) << "validation=" << stage.validation_sec
+               << ",preprocessing=" << stage.preprocessing_sec << ",run=" << stage.run_sec
+               << ",postprocessing=" << stage.postprocessing_sec;
+    std::cout << test_id << ":" << type_test_name << ":stages:" << stages_str.str() << '\n';
+
+    PrintThroughput(test_id, type_test_name);
+    PrintHwCounters(test_id, type_test_name);
+    PrintMpiProfiles(test_id, type_test_name);
+
+    const auto &ranks = perf_results_.rank_imbalance;
+    if (ranks.num_ranks == 0) {
+      return;
     }
-    auto end = perf_attr.current_timer();
-    perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
+    std::stringstream ranks_str;
+    ranks_str << std::fixed << std::setprecision(10) << "n=" << ranks.num_ranks;
+    const auto print_spread = [&ranks_str](const std::string &name, const RankSpread &spread) {
+      ranks_str << ";" << name << ":min=" << spread.min_sec << ",mean=" << spread.mean_sec << ",max=" << spread.max_sec
+                << ",imbalance=" << spread.imbalance << ",slowest=" << spread.slowest_rank;
+    };
+    print_spread("total", ranks.total);
+    print_spread("validation", ranks.validation);
+    print_spread("preprocessing", ranks.preprocessing);
+    print_spread("run", ranks.run);
+    print_spread("postprocessing", ranks.postprocessing);
+    std::cout << test_id << ":" << type_test_name << ":ranks:" << ranks_str.str() << '\n';
   }
 };
 
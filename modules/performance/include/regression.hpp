@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Outcome of a one-sided Mann-Whitney U test.
+struct MannWhitneyResult {
+  /// @brief U statistic of the first sample; pairs where it is greater count 1, ties count 1/2.
+  double u = 0.0;
+  /// @brief Standardized U with tie and continuity correction.
+  double z = 0.0;
+  /// @brief Probability of a U at least this large if the first sample is not stochastically greater.
+  double p_value = 1.0;
+};
+
+/// @brief Tests whether @p x tends to be greater than @p y without assuming a time distribution.
+/// @details Uses the normal approximation with tie correction, which is adequate from about 5 samples per side.
+/// @param x First sample, e.g. current iteration times.
+/// @param y Second sample, e.g. baseline iteration times.
+/// @return U statistic, z-score and one-sided p-value; p-value 1 if either sample is empty.
+MannWhitneyResult MannWhitneyGreater(const std::vector<double> &x, const std::vector<double> &y);
+
+/// @brief Thresholds of the regression gate.
+struct RegressionCriteria {
+  /// @brief Tolerated slowdown relative to the baseline, e.g. 0.1 for 10%.
+  double margin = 0.1;
+  /// @brief Significance level of the test.
+  double alpha = 0.05;
+};
+
+/// @brief Comparison of a run against its baseline.
+struct RegressionVerdict {
+  /// @brief Whether baseline samples were available.
+  bool has_baseline = false;
+  /// @brief Whether the run is significantly slower than the baseline plus the margin.
+  bool regressed = false;
+  /// @brief Median of the baseline samples in seconds.
+  double baseline_median_sec = 0.0;
+  /// @brief Median of the current samples divided by the baseline median.
+  double ratio = 0.0;
+  /// @brief One-sided p-value that the current samples exceed the baseline scaled by 1 + margin.
+  double p_value = 1.0;
+};
+
+/// @brief Decides whether @p samples are significantly slower than @p baseline by more than the margin.
+/// @param samples Current iteration times in seconds.
+/// @param baseline Baseline iteration times in seconds.
+/// @param criteria Margin and significance level.
+RegressionVerdict CompareWithBaseline(const std::vector<double> &samples, const std::vector<double> &baseline,
+                                      const RegressionCriteria &criteria);
+
+/// @brief Reads the iteration samples of a test from a JSON lines results file written by AppendPerfResults().
+/// @details The last record matching both @p test_id and @p type_of_running wins.
+/// @param path Path to the baseline file.
+/// @param test_id Test identifier.
+/// @param type_of_running "pipeline" or "task_run".
+/// @return Baseline samples in seconds; empty if the test is not in the file.
+/// @throws std::runtime_error If the file cannot be opened or contains a malformed record.
+std::vector<double> LoadBaselineSamples(const std::string &path, const std::string &test_id,
+                                        const std::string &type_of_running);
+
+}  // namespace ppc::performance
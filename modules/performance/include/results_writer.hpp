@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+
+#include "nlohmann/json_fwd.hpp"
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::performance {
+
+/// @brief Context of a performance run that is not part of PerfResults.
+struct PerfRunInfo {
+  /// @brief Test identifier as printed by Perf::PrintPerfStatistic.
+  std::string test_id;
+  /// @brief Implementation type of the measured task.
+  ppc::task::TypeOfTask type_of_task = ppc::task::TypeOfTask::kUnknown;
+  /// @brief Number of MPI processes the run used.
+  int num_procs = 1;
+  /// @brief Number of threads available to every process.
+  int num_threads = 1;
+};
+
+/// @brief Builds one structured record describing a performance run.
+/// @details Contains the run context, input size, all timing statistics with raw samples, stage means, hardware
+/// counters, cross-rank spread and host info.
+/// @param info Run context.
+/// @param results Results of the run.
+/// @return JSON object with one entry per field.
+nlohmann::json PerfResultsToJson(const PerfRunInfo &info, const PerfResults &results);
+
+/// @brief Returns the column names of the CSV results format, without a line break.
+std::string PerfResultsCsvHeader();
+
+/// @brief Formats the scalar part of a performance run record as one CSV row, without a line break.
+/// @param info Run context.
+/// @param results Results of the run.
+std::string PerfResultsToCsvRow(const PerfRunInfo &info, const PerfResults &results);
+
+/// @brief Appends one record to the results file.
+/// @details Files ending with ".csv" get a CSV row (and the header if the file is empty); any other file gets one JSON
+/// object per line.
+/// @param path Path to the results file; created if missing.
+/// @param info Run context.
+/// @param results Results of the run.
+/// @throws std::runtime_error If the file cannot be opened.
+void AppendPerfResults(const std::string &path, const PerfRunInfo &info, const PerfResults &results);
+
+}  // namespace ppc::performance
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief One run of a parallel implementation in a thread-count sweep.
+struct ScalingPoint {
+  /// @brief Prefix of the printed line, e.g. "<test>_t4:pipeline".
+  std::string label;
+  /// @brief Thread count of the run.
+  int threads = 1;
+  /// @brief Hardware threads the task occupied, the divisor of the parallel efficiency.
+  int workers = 1;
+  /// @brief Median time of the run in seconds.
+  double time_sec = 0.0;
+};
+
+/// @brief Reports speedup and parallel efficiency of sweep runs relative to the sequential implementation.
+/// @details Test cases of one task run in registration order, so the sequential reference may arrive before or after
+/// the parallel runs; points without a reference are held back until it is known.
+class ScalingReport {
+ public:
+  /// @brief Stores the sequential time of a task.
+  /// @param key Task and running mode shared by all implementations, see GetScalingKey().
+  /// @param time_sec Median time of the sequential implementation in seconds.
+  /// @return Lines of the held-back points of @p key.
+  std::vector<std::string> AddReference(const std::string &key, double time_sec);
+
+  /// @brief Adds a sweep run.
+  /// @return The line of @p point if the reference of @p key is known, otherwise nothing.
+  std::vector<std::string> AddPoint(const std::string &key, const ScalingPoint &point);
+
+  /// @brief Removes the points whose reference never arrived, e.g. because a test filter excluded the sequential run.
+  /// @return Their lines with the time but "n/a" for speedup and efficiency.
+  std::vector<std::string> TakePending();
+
+  /// @brief Formats "<label>:scaling:threads=..,workers=..,time_sec=..,speedup=..,efficiency=..".
+  static std::string FormatLine(const ScalingPoint &point, double reference_sec);
+
+ private:
+  std::map<std::string, double> references_;
+  std::map<std::string, std::vector<ScalingPoint>> pending_;
+};
+
+/// @brief Returns the key that pairs a perf test with the sequential implementation of the same task.
+/// @param test_name Name in the form "<task>_<type>_<status>", e.g. "nesterov_a_test_task_threads_omp_enabled".
+/// @param mode Running mode name, e.g. "pipeline".
+std::string GetScalingKey(const std::string &test_name, const std::string &mode);
+
+/// @brief Median time of one input size in a size sweep.
+struct SizePoint {
+  /// @brief Input size passed to the generator of the test.
+  std::size_t size = 0;
+  /// @brief Median time in seconds.
+  double time_sec = 0.0;
+};
+
+/// @brief Growth of the run time with the input size.
+struct ComplexityFit {
+  /// @brief Best matching model among O(1), O(log n), O(n), O(n log n), O(n^2) and O(n^3); empty if unknown.
+  std::string model;
+  /// @brief Slope of log(time) over log(size), e.g. 1 for linear growth.
+  double exponent = 0.0;
+  /// @brief Coefficient of determination of the log-log fit.
+  double r_squared = 0.0;
+};
+
+/// @brief Fits a time-versus-size curve.
+/// @details The model is the one whose least-squares fit time = c * f(n) has the smallest relative RMS error.
+/// @return An empty model if the curve has fewer than two distinct sizes or a non-positive time.
+ComplexityFit FitComplexity(const std::vector<SizePoint> &curve);
+
+/// @brief Formats a size sweep as one "<label>:size:n=..,time_sec=..,elements_per_sec=.." line per point and a final
+/// "<label>:complexity:model=..,exponent=..,r2=.." line.
+std::vector<std::string> FormatSizeCurve(const std::string &label, const std::vector<SizePoint> &curve);
+
+}  // namespace ppc::performance
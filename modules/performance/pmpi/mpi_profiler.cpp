@@ -0,0 +1,179 @@
+// PMPI interposition layer: every wrapped MPI routine is forwarded to its PMPI_ counterpart and accounted in
+// ppc::performance::MpiProfile. Linked into ppc_perf_tests only when USE_MPI_PROFILER is enabled.
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <numeric>
+
+#include "performance/include/mpi_profile.hpp"
+
+namespace {
+
+using ppc::performance::MpiProfile;
+using ppc::performance::MpiRoutine;
+
+const bool kProfilerEnabled = [] {
+  MpiProfile::Enable();
+  return true;
+}();
+
+uint64_t Bytes(int count, MPI_Datatype datatype) {
+  if (count <= 0 || datatype == MPI_DATATYPE_NULL) {
+    return 0;
+  }
+  int type_size = 0;
+  PMPI_Type_size(datatype, &type_size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(type_size);
+}
+
+uint64_t SendBytes(const void *sendbuf, int count, MPI_Datatype datatype) {
+  return sendbuf == MPI_IN_PLACE ? 0 : Bytes(count, datatype);
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  return size;
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+int SumCounts(const int counts[], MPI_Comm comm) {
+  return std::accumulate(counts, counts + CommSize(comm), 0);
+}
+
+template <typename Call>
+int Profile(MpiRoutine routine, uint64_t bytes, Call call) {
+  const double begin = PMPI_Wtime();
+  const int result = call();
+  MpiProfile::Record(routine, bytes, PMPI_Wtime() - begin);
+  return result;
+}
+
+}  // namespace
+
+extern "C" {
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return Profile(MpiRoutine::kSend, Bytes(count, datatype),
+                 [&] { return PMPI_Send(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  return Profile(MpiRoutine::kRecv, Bytes(count, datatype),
+                 [&] { return PMPI_Recv(buf, count, datatype, source, tag, comm, status); });
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return Profile(MpiRoutine::kIsend, Bytes(count, datatype),
+                 [&] { return PMPI_Isend(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return Profile(MpiRoutine::kIrecv, Bytes(count, datatype),
+                 [&] { return PMPI_Irecv(buf, count, datatype, source, tag, comm, request); });
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  return Profile(MpiRoutine::kSendrecv, Bytes(sendcount, sendtype) + Bytes(recvcount, recvtype), [&] {
+    return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                         comm, status);
+  });
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  return Profile(MpiRoutine::kWait, 0, [&] { return PMPI_Wait(request, status); });
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status *array_of_statuses) {
+  return Profile(MpiRoutine::kWaitall, 0, [&] { return PMPI_Waitall(count, array_of_requests, array_of_statuses); });
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  return Profile(MpiRoutine::kBcast, Bytes(count, datatype),
+                 [&] { return PMPI_Bcast(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t root_bytes = Bytes(sendcount, sendtype) * static_cast<uint64_t>(CommSize(comm));
+  const uint64_t bytes = IsRoot(root, comm) ? root_bytes : Bytes(recvcount, recvtype);
+  return Profile(MpiRoutine::kScatter, bytes, [&] {
+    return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t bytes = IsRoot(root, comm) ? Bytes(SumCounts(sendcounts, comm), sendtype) : Bytes(recvcount, recvtype);
+  return Profile(MpiRoutine::kScatterv, bytes, [&] {
+    return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Iscatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype, void *recvbuf,
+                  int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  const uint64_t bytes = IsRoot(root, comm) ? Bytes(SumCounts(sendcounts, comm), sendtype) : Bytes(recvcount, recvtype);
+  return Profile(MpiRoutine::kIscatterv, bytes, [&] {
+    return PMPI_Iscatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm, request);
+  });
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t root_bytes = Bytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm));
+  const uint64_t bytes = IsRoot(root, comm) ? root_bytes : Bytes(sendcount, sendtype);
+  return Profile(MpiRoutine::kGather, bytes, [&] {
+    return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t bytes = IsRoot(root, comm) ? Bytes(SumCounts(recvcounts, comm), recvtype) : Bytes(sendcount, sendtype);
+  return Profile(MpiRoutine::kGatherv, bytes, [&] {
+    return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+  });
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t bytes = SendBytes(sendbuf, sendcount, sendtype) +
+                         (Bytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm)));
+  return Profile(MpiRoutine::kAllgather, bytes, [&] {
+    return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t bytes = SendBytes(sendbuf, sendcount, sendtype) + Bytes(SumCounts(recvcounts, comm), recvtype);
+  return Profile(MpiRoutine::kAllgatherv, bytes, [&] {
+    return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+  });
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  return Profile(MpiRoutine::kReduce, Bytes(count, datatype),
+                 [&] { return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm); });
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  return Profile(MpiRoutine::kAllreduce, Bytes(count, datatype),
+                 [&] { return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  return Profile(MpiRoutine::kBarrier, 0, [&] { return PMPI_Barrier(comm); });
+}
+
+}  // extern "C"
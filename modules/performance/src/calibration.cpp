@@ -0,0 +1,297 @@
+#include "performance/include/calibration.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+constexpr std::size_t kStreamElements = std::size_t{1} << 23;
+constexpr int kStreamRepetitions = 5;
+constexpr double kStreamScalar = 3.0;
+constexpr std::size_t kPingPongSmallMessage = std::size_t{1} << 16;
+constexpr int kPingPongSmallRounds = 100;
+constexpr int kPingPongLargeRounds = 10;
+
+// Fastest of several runs of a kernel in seconds
+template <typename Kernel>
+double BestTime(int repetitions, const Kernel &kernel) {
+  double best = std::numeric_limits<double>::max();
+  for (int rep = 0; rep < repetitions; rep++) {
+    const double begin = omp_get_wtime();
+    kernel();
+    best = std::min(best, omp_get_wtime() - begin);
+  }
+  return best;
+}
+
+double ToGbs(double bytes, double seconds) {
+  return seconds > 0.0 ? bytes / seconds * 1e-9 : 0.0;
+}
+
+std::vector<std::size_t> PingPongSizes() {
+  std::vector<std::size_t> sizes;
+  for (std::size_t bytes = 8; bytes <= (std::size_t{1} << 22); bytes *= 8) {
+    sizes.push_back(bytes);
+  }
+  return sizes;
+}
+
+std::vector<int> StreamThreadCounts(int max_threads) {
+  std::vector<int> counts;
+  for (int threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(std::max(max_threads, 1));
+  return counts;
+}
+
+// Rank 0 reads the cached calibration; empty if there is none
+std::string ReadCache(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return {};
+  }
+  std::stringstream text;
+  text << file.rdbuf();
+  const auto json = nlohmann::json::parse(text.str(), nullptr, false);
+  return json.is_discarded() ? std::string{} : text.str();
+}
+
+void PrintCalibration(const ppc::performance::Calibration &calibration, const std::string &path) {
+  std::cout << "calibration:cache:" << path << '\n';
+  for (const auto &result : calibration.stream) {
+    std::cout << "calibration:stream:threads=" << result.threads << ",copy_gbs=" << result.copy_gbs
+              << ",scale_gbs=" << result.scale_gbs << ",add_gbs=" << result.add_gbs
+              << ",triad_gbs=" << result.triad_gbs << '\n';
+  }
+  for (const auto &result : calibration.ping_pong) {
+    std::cout << "calibration:ping_pong:bytes=" << result.bytes << ",latency_us=" << result.latency_us
+              << ",bandwidth_gbs=" << result.bandwidth_gbs << '\n';
+  }
+}
+
+// Barrier that sleeps between polls; a blocking MPI call would keep a core busy while another process measures
+void IdleBarrier() {
+  MPI_Request request = MPI_REQUEST_NULL;
+  MPI_Ibarrier(MPI_COMM_WORLD, &request);
+  int done = 0;
+  MPI_Test(&request, &done, MPI_STATUS_IGNORE);
+  while (done == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    MPI_Test(&request, &done, MPI_STATUS_IGNORE);
+  }
+}
+
+void BcastString(std::string &text) {
+  int length = static_cast<int>(text.size());
+  MPI_Bcast(&length, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  text.resize(static_cast<std::size_t>(length));
+  MPI_Bcast(text.data(), length, MPI_CHAR, 0, MPI_COMM_WORLD);
+}
+
+}  // namespace
+
+double ppc::performance::Calibration::PeakBandwidthGbs(int threads) const {
+  double peak = 0.0;
+  for (const auto &result : stream) {
+    if (result.threads <= threads || peak == 0.0) {
+      peak = result.triad_gbs;
+    }
+  }
+  return peak;
+}
+
+ppc::performance::StreamResult ppc::performance::MeasureStream(int threads, std::size_t elements, int repetitions) {
+  const auto n = static_cast<std::int64_t>(elements);
+  auto a_ptr = std::make_unique_for_overwrite<double[]>(elements);
+  auto b_ptr = std::make_unique_for_overwrite<double[]>(elements);
+  auto c_ptr = std::make_unique_for_overwrite<double[]>(elements);
+  double *a = a_ptr.get();
+  double *b = b_ptr.get();
+  double *c = c_ptr.get();
+  const double s = kStreamScalar;
+
+  // First touch by the measuring threads places the pages close to them
+#pragma omp parallel for default(none) shared(a, b, c, n) num_threads(threads)
+  for (std::int64_t i = 0; i < n; i++) {
+    a[i] = 1.0;
+    b[i] = 2.0;
+    c[i] = 0.0;
+  }
+
+  const double copy_sec = BestTime(repetitions, [&] {
+#pragma omp parallel for default(none) shared(a, c, n) num_threads(threads)
+    for (std::int64_t i = 0; i < n; i++) {
+      c[i] = a[i];
+    }
+  });
+  const double scale_sec = BestTime(repetitions, [&] {
+#pragma omp parallel for default(none) shared(b, c, n, s) num_threads(threads)
+    for (std::int64_t i = 0; i < n; i++) {
+      b[i] = s * c[i];
+    }
+  });
+  const double add_sec = BestTime(repetitions, [&] {
+#pragma omp parallel for default(none) shared(a, b, c, n) num_threads(threads)
+    for (std::int64_t i = 0; i < n; i++) {
+      c[i] = a[i] + b[i];
+    }
+  });
+  const double triad_sec = BestTime(repetitions, [&] {
+#pragma omp parallel for default(none) shared(a, b, c, n, s) num_threads(threads)
+    for (std::int64_t i = 0; i < n; i++) {
+      a[i] = b[i] + (s * c[i]);
+    }
+  });
+
+  const auto array_bytes = static_cast<double>(elements * sizeof(double));
+  return {.threads = threads,
+          .copy_gbs = ToGbs(2.0 * array_bytes, copy_sec),
+          .scale_gbs = ToGbs(2.0 * array_bytes, scale_sec),
+          .add_gbs = ToGbs(3.0 * array_bytes, add_sec),
+          .triad_gbs = ToGbs(3.0 * array_bytes, triad_sec)};
+}
+
+std::vector<ppc::performance::PingPongResult> ppc::performance::MeasurePingPong(
+    const std::vector<std::size_t> &sizes) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  if (size < 2 || sizes.empty()) {
+    return {};
+  }
+
+  std::vector<char> buffer(std::ranges::max(sizes));
+  std::vector<double> round_trips(sizes.size(), 0.0);
+  for (std::size_t k = 0; k < sizes.size(); k++) {
+    const int count = static_cast<int>(sizes[k]);
+    const int rounds = sizes[k] <= kPingPongSmallMessage ? kPingPongSmallRounds : kPingPongLargeRounds;
+    MPI_Barrier(MPI_COMM_WORLD);
+    double best = std::numeric_limits<double>::max();
+    for (int round = 0; round < rounds && rank < 2; round++) {
+      const double begin = MPI_Wtime();
+      if (rank == 0) {
+        MPI_Send(buffer.data(), count, MPI_CHAR, 1, 0, MPI_COMM_WORLD);
+        MPI_Recv(buffer.data(), count, MPI_CHAR, 1, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      } else {
+        MPI_Recv(buffer.data(), count, MPI_CHAR, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Send(buffer.data(), count, MPI_CHAR, 0, 0, MPI_COMM_WORLD);
+      }
+      best = std::min(best, MPI_Wtime() - begin);
+    }
+    round_trips[k] = best;
+  }
+  // Rank 0 starts every round trip, so its timings are the accurate ones
+  MPI_Bcast(round_trips.data(), static_cast<int>(round_trips.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  std::vector<PingPongResult> results(sizes.size());
+  for (std::size_t k = 0; k < sizes.size(); k++) {
+    const double one_way = round_trips[k] / 2.0;
+    results[k] = {.bytes = sizes[k],
+                  .latency_us = one_way * 1e6,
+                  .bandwidth_gbs = ToGbs(static_cast<double>(sizes[k]), one_way)};
+  }
+  return results;
+}
+
+nlohmann::json ppc::performance::CalibrationToJson(const Calibration &calibration) {
+  auto stream = nlohmann::json::array();
+  for (const auto &result : calibration.stream) {
+    stream.push_back({{"threads", result.threads},
+                      {"copy_gbs", result.copy_gbs},
+                      {"scale_gbs", result.scale_gbs},
+                      {"add_gbs", result.add_gbs},
+                      {"triad_gbs", result.triad_gbs}});
+  }
+  auto ping_pong = nlohmann::json::array();
+  for (const auto &result : calibration.ping_pong) {
+    ping_pong.push_back(
+        {{"bytes", result.bytes}, {"latency_us", result.latency_us}, {"bandwidth_gbs", result.bandwidth_gbs}});
+  }
+  return {{"stream", stream}, {"ping_pong", ping_pong}};
+}
+
+ppc::performance::Calibration ppc::performance::CalibrationFromJson(const nlohmann::json &json) {
+  Calibration calibration;
+  for (const auto &result : json.at("stream")) {
+    calibration.stream.push_back({.threads = result.at("threads").get<int>(),
+                                  .copy_gbs = result.at("copy_gbs").get<double>(),
+                                  .scale_gbs = result.at("scale_gbs").get<double>(),
+                                  .add_gbs = result.at("add_gbs").get<double>(),
+                                  .triad_gbs = result.at("triad_gbs").get<double>()});
+  }
+  for (const auto &result : json.at("ping_pong")) {
+    calibration.ping_pong.push_back({.bytes = result.at("bytes").get<std::size_t>(),
+                                     .latency_us = result.at("latency_us").get<double>(),
+                                     .bandwidth_gbs = result.at("bandwidth_gbs").get<double>()});
+  }
+  return calibration;
+}
+
+std::string ppc::performance::GetCalibrationCachePath(int num_procs, int max_threads) {
+  // Next to the per-test directories of ScopedPerTestEnv, so that all tests and later jobs share it
+  const auto test_tmp = env::get<std::string>("PPC_TEST_TMPDIR");
+  const auto dir = test_tmp.has_value() ? std::filesystem::path(*test_tmp).parent_path()
+                                        : std::filesystem::temp_directory_path();
+  const auto name = "ppc_calibration_" + ppc::util::test::SanitizeToken(ppc::util::GetHostName()) + "_np" +
+                    std::to_string(num_procs) + "_t" + std::to_string(max_threads) + ".json";
+  return (dir / name).string();
+}
+
+const ppc::performance::Calibration &ppc::performance::GetCalibration(int max_threads) {
+  static std::map<int, Calibration> calibrations;
+  if (const auto it = calibrations.find(max_threads); it != calibrations.end()) {
+    return it->second;
+  }
+
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto path = GetCalibrationCachePath(size, max_threads);
+
+  std::string text = rank == 0 ? ReadCache(path) : std::string{};
+  BcastString(text);
+  if (text.empty()) {
+    // STREAM has the cores of the node to itself: the other processes only wake up now and then to see it finish
+    Calibration measured;
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == 0) {
+      for (const int threads : StreamThreadCounts(max_threads)) {
+        measured.stream.push_back(MeasureStream(threads, kStreamElements, kStreamRepetitions));
+      }
+    }
+    IdleBarrier();
+    measured.ping_pong = MeasurePingPong(PingPongSizes());
+    if (rank == 0) {
+      text = CalibrationToJson(measured).dump();
+      std::ofstream(path) << text << '\n';
+    }
+    BcastString(text);
+  }
+  const auto &calibration =
+      calibrations.emplace(max_threads, CalibrationFromJson(nlohmann::json::parse(text))).first->second;
+  if (rank == 0) {
+    PrintCalibration(calibration, path);
+  }
+  return calibration;
+}
@@ -0,0 +1,132 @@
+#include "performance/include/hw_counters.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <array>
+#endif
+
+namespace {
+
+#ifdef __linux__
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr std::array<EventConfig, ppc::performance::kHwCounterCount> kEvents = {{
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CPU_CYCLES},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_INSTRUCTIONS},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CACHE_MISSES},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_MISSES},
+    {.type = PERF_TYPE_HW_CACHE,
+     .config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+               (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16)},
+}};
+
+int OpenEvent(const EventConfig &event) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+}  // namespace
+
+ppc::performance::HwCounterGroup::HwCounterGroup() {
+  fds_.fill(-1);
+}
+
+ppc::performance::HwCounterGroup::~HwCounterGroup() {
+  Close();
+}
+
+bool ppc::performance::HwCounterGroup::Open() {
+  Close();
+  bool any = false;
+#ifdef __linux__
+  for (std::size_t i = 0; i < kHwCounterCount; i++) {
+    fds_[i] = OpenEvent(kEvents[i]);
+    any = any || fds_[i] >= 0;
+  }
+#endif
+  return any;
+}
+
+void ppc::performance::HwCounterGroup::Close() {
+  for (auto &fd : fds_) {
+#ifdef __linux__
+    if (fd >= 0) {
+      close(fd);
+    }
+#endif
+    fd = -1;
+  }
+}
+
+bool ppc::performance::HwCounterGroup::IsAvailable(HwCounter counter) const {
+  return fds_[static_cast<std::size_t>(counter)] >= 0;
+}
+
+void ppc::performance::HwCounterGroup::Reset() {
+#ifdef __linux__
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    }
+  }
+#endif
+}
+
+void ppc::performance::HwCounterGroup::Enable() {
+#ifdef __linux__
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+void ppc::performance::HwCounterGroup::Disable() {
+#ifdef __linux__
+  for (const int fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+#endif
+}
+
+ppc::performance::HwCounterValues ppc::performance::HwCounterGroup::Read() const {
+  HwCounterValues values{};
+#ifdef __linux__
+  for (std::size_t i = 0; i < kHwCounterCount; i++) {
+    // value, time enabled, time running
+    std::array<uint64_t, 3> data{};
+    if (fds_[i] < 0 || read(fds_[i], data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+      continue;
+    }
+    if (data[2] == 0 || data[2] == data[1]) {
+      values[i] = data[0];
+    } else {
+      values[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                        static_cast<double>(data[2]));
+    }
+  }
+#endif
+  return values;
+}
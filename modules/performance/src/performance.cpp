@@ -0,0 +1,96 @@
+#include "performance/include/performance.hpp"
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "performance/include/mpi_profile.hpp"
+
+namespace {
+
+constexpr std::size_t kMetricsCount = 5;
+
+std::array<double, kMetricsCount> PackMetrics(const ppc::performance::PerfResults &results) {
+  const auto &stage = results.stage_mean;
+  return {results.time_sec, stage.validation_sec, stage.preprocessing_sec, stage.run_sec, stage.postprocessing_sec};
+}
+
+std::vector<double> ExtractMetric(const std::vector<double> &gathered, std::size_t metric) {
+  std::vector<double> per_rank(gathered.size() / kMetricsCount);
+  for (std::size_t rank = 0; rank < per_rank.size(); rank++) {
+    per_rank[rank] = gathered[(rank * kMetricsCount) + metric];
+  }
+  return per_rank;
+}
+
+}  // namespace
+
+ppc::performance::RankImbalance ppc::performance::GatherRankImbalance(const PerfResults &local) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const auto metrics = PackMetrics(local);
+  std::vector<double> gathered(rank == 0 ? static_cast<std::size_t>(size) * kMetricsCount : 0);
+  MPI_Gather(metrics.data(), static_cast<int>(kMetricsCount), MPI_DOUBLE, gathered.data(),
+             static_cast<int>(kMetricsCount), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  RankImbalance imbalance;
+  if (rank != 0) {
+    return imbalance;
+  }
+  imbalance.num_ranks = size;
+  imbalance.total = ComputeRankSpread(ExtractMetric(gathered, 0));
+  imbalance.validation = ComputeRankSpread(ExtractMetric(gathered, 1));
+  imbalance.preprocessing = ComputeRankSpread(ExtractMetric(gathered, 2));
+  imbalance.run = ComputeRankSpread(ExtractMetric(gathered, 3));
+  imbalance.postprocessing = ComputeRankSpread(ExtractMetric(gathered, 4));
+  return imbalance;
+}
+
+std::vector<ppc::performance::MpiProfileTable> ppc::performance::GatherMpiProfiles(const MpiProfileTable &local) {
+  constexpr std::size_t kEntries = ppc::util::kActiveStageCount * kMpiRoutineCount;
+  int rank = 0;
+  int size = 0;
+  PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::vector<uint64_t> local_counters(2 * kEntries);
+  std::vector<double> local_times(kEntries);
+  std::size_t entry = 0;
+  for (const auto &stage : local) {
+    for (const auto &stats : stage) {
+      local_counters[2 * entry] = stats.calls;
+      local_counters[(2 * entry) + 1] = stats.bytes;
+      local_times[entry] = stats.time_sec;
+      entry++;
+    }
+  }
+
+  const std::size_t root_size = rank == 0 ? static_cast<std::size_t>(size) : 0;
+  std::vector<uint64_t> counters(root_size * 2 * kEntries);
+  std::vector<double> times(root_size * kEntries);
+  PMPI_Gather(local_counters.data(), static_cast<int>(local_counters.size()), MPI_UINT64_T, counters.data(),
+              static_cast<int>(local_counters.size()), MPI_UINT64_T, 0, MPI_COMM_WORLD);
+  PMPI_Gather(local_times.data(), static_cast<int>(local_times.size()), MPI_DOUBLE, times.data(),
+              static_cast<int>(local_times.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  std::vector<MpiProfileTable> profiles(root_size);
+  for (std::size_t proc = 0; proc < root_size; proc++) {
+    entry = 0;
+    for (auto &stage : profiles[proc]) {
+      for (auto &stats : stage) {
+        const std::size_t offset = (proc * kEntries) + entry;
+        stats.calls = counters[2 * offset];
+        stats.bytes = counters[(2 * offset) + 1];
+        stats.time_sec = times[offset];
+        entry++;
+      }
+    }
+  }
+  return profiles;
+}
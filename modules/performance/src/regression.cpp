@@ -0,0 +1,121 @@
+#include "performance/include/regression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace {
+
+double Median(std::vector<double> values) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::ranges::sort(values);
+  const auto mid = values.size() / 2;
+  return values.size() % 2 == 1 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+}  // namespace
+
+ppc::performance::MannWhitneyResult ppc::performance::MannWhitneyGreater(const std::vector<double> &x,
+                                                                         const std::vector<double> &y) {
+  MannWhitneyResult result;
+  if (x.empty() || y.empty()) {
+    return result;
+  }
+
+  // Pool both samples, rank them with averaged ranks for ties and sum the ranks of x
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(x.size() + y.size());
+  for (const double value : x) {
+    pooled.emplace_back(value, true);
+  }
+  for (const double value : y) {
+    pooled.emplace_back(value, false);
+  }
+  std::ranges::sort(pooled, {}, &std::pair<double, bool>::first);
+
+  double rank_sum_x = 0.0;
+  double tie_term = 0.0;
+  for (std::size_t begin = 0; begin < pooled.size();) {
+    std::size_t end = begin;
+    while (end < pooled.size() && pooled[end].first == pooled[begin].first) {
+      end++;
+    }
+    const double ties = static_cast<double>(end - begin);
+    const double average_rank = (static_cast<double>(begin + end) + 1.0) / 2.0;
+    for (std::size_t i = begin; i < end; i++) {
+      if (pooled[i].second) {
+        rank_sum_x += average_rank;
+      }
+    }
+    tie_term += (ties * ties * ties) - ties;
+    begin = end;
+  }
+
+  const auto n1 = static_cast<double>(x.size());
+  const auto n2 = static_cast<double>(y.size());
+  const double n = n1 + n2;
+  result.u = rank_sum_x - (n1 * (n1 + 1.0) / 2.0);
+  const double mean = n1 * n2 / 2.0;
+  const double variance = (n1 * n2 / 12.0) * ((n + 1.0) - (tie_term / (n * (n - 1.0))));
+  if (variance <= 0.0) {
+    result.p_value = result.u > mean ? 0.0 : 1.0;
+    return result;
+  }
+  result.z = (result.u - mean - 0.5) / std::sqrt(variance);
+  result.p_value = 0.5 * std::erfc(result.z / std::numbers::sqrt2);
+  return result;
+}
+
+ppc::performance::RegressionVerdict ppc::performance::CompareWithBaseline(const std::vector<double> &samples,
+                                                                          const std::vector<double> &baseline,
+                                                                          const RegressionCriteria &criteria) {
+  RegressionVerdict verdict;
+  if (baseline.empty()) {
+    return verdict;
+  }
+  verdict.has_baseline = true;
+  verdict.baseline_median_sec = Median(baseline);
+  verdict.ratio = verdict.baseline_median_sec > 0.0 ? Median(samples) / verdict.baseline_median_sec : 0.0;
+
+  // Shifting the baseline by the margin makes the null hypothesis "at most margin slower"
+  std::vector<double> tolerated(baseline.size());
+  std::ranges::transform(baseline, tolerated.begin(), [&](double value) { return value * (1.0 + criteria.margin); });
+  verdict.p_value = MannWhitneyGreater(samples, tolerated).p_value;
+  verdict.regressed = verdict.p_value < criteria.alpha;
+  return verdict;
+}
+
+std::vector<double> ppc::performance::LoadBaselineSamples(const std::string &path, const std::string &test_id,
+                                                          const std::string &type_of_running) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+
+  std::vector<double> samples;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    const auto record = nlohmann::json::parse(line, nullptr, false);
+    if (record.is_discarded() || !record.is_object()) {
+      throw std::runtime_error("Malformed record in " + path);
+    }
+    if (record.value("test_id", "") == test_id && record.value("type_of_running", "") == type_of_running &&
+        record.contains("samples_sec")) {
+      samples = record["samples_sec"].get<std::vector<double>>();
+    }
+  }
+  return samples;
+}
@@ -0,0 +1,175 @@
+#include "performance/include/results_writer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "nlohmann/json.hpp"
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+std::string_view GetOsName() {
+#if defined(_WIN32)
+  return "windows";
+#elif defined(__APPLE__)
+  return "macos";
+#elif defined(__linux__)
+  return "linux";
+#else
+  return "unknown";
+#endif
+}
+
+std::string GetCompilerName() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_VER);
+#else
+  return "unknown";
+#endif
+}
+
+int64_t GetUnixTime() {
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::seconds>(now).count();
+}
+
+nlohmann::json StageTimesToJson(const ppc::task::StageTimes &stage) {
+  return {{"validation_sec", stage.validation_sec},
+          {"preprocessing_sec", stage.preprocessing_sec},
+          {"run_sec", stage.run_sec},
+          {"postprocessing_sec", stage.postprocessing_sec}};
+}
+
+nlohmann::json RankSpreadToJson(const ppc::performance::RankSpread &spread) {
+  return {{"min_sec", spread.min_sec},
+          {"mean_sec", spread.mean_sec},
+          {"max_sec", spread.max_sec},
+          {"imbalance", spread.imbalance},
+          {"slowest_rank", spread.slowest_rank}};
+}
+
+// Quotes a CSV field if it contains a separator, a quote or a line break
+std::string CsvField(const std::string &value) {
+  if (value.find_first_of(",\"\n") == std::string::npos) {
+    return value;
+  }
+  std::string quoted = "\"";
+  for (const char ch : value) {
+    quoted += ch;
+    if (ch == '"') {
+      quoted += '"';
+    }
+  }
+  return quoted + "\"";
+}
+
+}  // namespace
+
+nlohmann::json ppc::performance::PerfResultsToJson(const PerfRunInfo &info, const PerfResults &results) {
+  nlohmann::json record;
+  record["test_id"] = info.test_id;
+  record["type_of_task"] = ppc::task::TypeOfTaskToString(info.type_of_task);
+  record["type_of_running"] = GetStringParamName(results.type_of_running);
+  record["num_procs"] = info.num_procs;
+  record["num_threads"] = info.num_threads;
+  record["num_elements"] = results.num_elements;
+
+  record["time_sec"] = results.time_sec;
+  record["min_sec"] = results.min_sec;
+  record["median_sec"] = results.median_sec;
+  record["p90_sec"] = results.p90_sec;
+  record["p99_sec"] = results.p99_sec;
+  record["max_sec"] = results.max_sec;
+  record["stddev_sec"] = results.stddev_sec;
+  record["median_rel_ci"] = results.median_rel_ci;
+  record["samples_sec"] = results.samples_sec;
+  record["stages"] = StageTimesToJson(results.stage_mean);
+
+  const auto &work = results.work_units;
+  record["work_units"] = {
+      {"bytes_read", work.bytes_read}, {"bytes_written", work.bytes_written}, {"operations", work.operations}};
+  record["bandwidth_gbs"] = results.bandwidth_gbs;
+  record["elements_per_sec"] = results.elements_per_sec;
+  if (results.peak_bandwidth_gbs > 0.0) {
+    record["peak_bandwidth_gbs"] = results.peak_bandwidth_gbs;
+  }
+
+  if (results.hw_counters.requested) {
+    auto &hw = record["hw_counters"] = nlohmann::json::object();
+    for (std::size_t i = 0; i < kHwCounterCount; i++) {
+      if (results.hw_counters.available[i]) {
+        hw[std::string(GetHwCounterName(static_cast<HwCounter>(i)))] = results.hw_counters.mean[i];
+      }
+    }
+  }
+
+  const auto &ranks = results.rank_imbalance;
+  if (ranks.num_ranks > 0) {
+    record["ranks"] = {{"num_ranks", ranks.num_ranks},
+                       {"total", RankSpreadToJson(ranks.total)},
+                       {"validation", RankSpreadToJson(ranks.validation)},
+                       {"preprocessing", RankSpreadToJson(ranks.preprocessing)},
+                       {"run", RankSpreadToJson(ranks.run)},
+                       {"postprocessing", RankSpreadToJson(ranks.postprocessing)}};
+  }
+
+  record["host"] = {{"name", ppc::util::GetHostName()},
+                    {"os", GetOsName()},
+                    {"hardware_concurrency", std::thread::hardware_concurrency()},
+                    {"compiler", GetCompilerName()}};
+  record["timestamp_unix"] = GetUnixTime();
+  return record;
+}
+
+std::string ppc::performance::PerfResultsCsvHeader() {
+  return "test_id,type_of_task,type_of_running,num_procs,num_threads,num_elements,time_sec,min_sec,median_sec,"
+         "p90_sec,p99_sec,max_sec,stddev_sec,median_rel_ci,n,bandwidth_gbs,elements_per_sec,host,timestamp_unix";
+}
+
+std::string ppc::performance::PerfResultsToCsvRow(const PerfRunInfo &info, const PerfResults &results) {
+  std::stringstream row;
+  row << std::fixed << std::setprecision(10) << CsvField(info.test_id) << ","
+      << ppc::task::TypeOfTaskToString(info.type_of_task) << "," << GetStringParamName(results.type_of_running) << ","
+      << info.num_procs << "," << info.num_threads << "," << results.num_elements << "," << results.time_sec << ","
+      << results.min_sec << "," << results.median_sec << "," << results.p90_sec << "," << results.p99_sec << ","
+      << results.max_sec << "," << results.stddev_sec << "," << results.median_rel_ci << ","
+      << results.samples_sec.size() << "," << results.bandwidth_gbs << "," << results.elements_per_sec << ","
+      << CsvField(ppc::util::GetHostName()) << "," << GetUnixTime();
+  return row.str();
+}
+
+void ppc::performance::AppendPerfResults(const std::string &path, const PerfRunInfo &info,
+                                         const PerfResults &results) {
+  const bool is_csv = std::filesystem::path(path).extension() == ".csv";
+  std::error_code ec;
+  const bool is_empty = !std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0;
+
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  if (is_csv) {
+    if (is_empty) {
+      file << PerfResultsCsvHeader() << '\n';
+    }
+    file << PerfResultsToCsvRow(info, results) << '\n';
+  } else {
+    file << PerfResultsToJson(info, results).dump() << '\n';
+  }
+}
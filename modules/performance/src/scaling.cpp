@@ -0,0 +1,164 @@
+#include "performance/include/scaling.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct ComplexityModel {
+  const char *name;
+  double (*growth)(double n);
+};
+
+const std::array<ComplexityModel, 6> kComplexityModels = {{
+    {.name = "O(1)", .growth = [](double /*n*/) { return 1.0; }},
+    {.name = "O(log n)", .growth = [](double n) { return std::log2(n); }},
+    {.name = "O(n)", .growth = [](double n) { return n; }},
+    {.name = "O(n log n)", .growth = [](double n) { return n * std::log2(n); }},
+    {.name = "O(n^2)", .growth = [](double n) { return n * n; }},
+    {.name = "O(n^3)", .growth = [](double n) { return n * n * n; }},
+}};
+
+// Relative RMS error of the least-squares fit time = c * growth(n); infinity if growth vanishes everywhere
+double RelativeFitError(const std::vector<ppc::performance::SizePoint> &curve, double (*growth)(double)) {
+  double num = 0.0;
+  double den = 0.0;
+  for (const auto &point : curve) {
+    const double f = growth(static_cast<double>(point.size));
+    num += f * point.time_sec;
+    den += f * f;
+  }
+  if (den <= 0.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const double c = num / den;
+  double error = 0.0;
+  for (const auto &point : curve) {
+    const double rel = ((c * growth(static_cast<double>(point.size))) - point.time_sec) / point.time_sec;
+    error += rel * rel;
+  }
+  return std::sqrt(error / static_cast<double>(curve.size()));
+}
+
+}  // namespace
+
+std::vector<std::string> ppc::performance::ScalingReport::AddReference(const std::string &key, double time_sec) {
+  references_[key] = time_sec;
+  std::vector<std::string> lines;
+  const auto pending = pending_.find(key);
+  if (pending != pending_.end()) {
+    for (const auto &point : pending->second) {
+      lines.push_back(FormatLine(point, time_sec));
+    }
+    pending_.erase(pending);
+  }
+  return lines;
+}
+
+std::vector<std::string> ppc::performance::ScalingReport::AddPoint(const std::string &key, const ScalingPoint &point) {
+  const auto reference = references_.find(key);
+  if (reference == references_.end()) {
+    pending_[key].push_back(point);
+    return {};
+  }
+  return {FormatLine(point, reference->second)};
+}
+
+std::vector<std::string> ppc::performance::ScalingReport::TakePending() {
+  std::vector<std::string> lines;
+  for (const auto &[key, points] : pending_) {
+    for (const auto &point : points) {
+      std::stringstream line;
+      line << point.label << ":scaling:threads=" << point.threads << ",workers=" << point.workers << std::fixed
+           << std::setprecision(10) << ",time_sec=" << point.time_sec << ",speedup=n/a,efficiency=n/a";
+      lines.push_back(line.str());
+    }
+  }
+  pending_.clear();
+  return lines;
+}
+
+std::string ppc::performance::ScalingReport::FormatLine(const ScalingPoint &point, double reference_sec) {
+  const double speedup = point.time_sec > 0.0 ? reference_sec / point.time_sec : 0.0;
+  const double efficiency = point.workers > 0 ? speedup / point.workers : 0.0;
+  std::stringstream line;
+  line << point.label << ":scaling:threads=" << point.threads << ",workers=" << point.workers << std::fixed
+       << std::setprecision(10) << ",time_sec=" << point.time_sec << std::setprecision(4) << ",speedup=" << speedup
+       << ",efficiency=" << efficiency;
+  return line.str();
+}
+
+std::string ppc::performance::GetScalingKey(const std::string &test_name, const std::string &mode) {
+  // Drop the "_<type>_<status>" suffix added by ppc::task::GetStringTaskType()
+  auto task_end = test_name.rfind('_');
+  if (task_end != std::string::npos && task_end > 0) {
+    task_end = test_name.rfind('_', task_end - 1);
+  }
+  return test_name.substr(0, task_end) + ":" + mode;
+}
+
+ppc::performance::ComplexityFit ppc::performance::FitComplexity(const std::vector<SizePoint> &curve) {
+  ComplexityFit fit;
+  const auto n = static_cast<double>(curve.size());
+  double sx = 0.0;
+  double sy = 0.0;
+  double sxx = 0.0;
+  double sxy = 0.0;
+  double syy = 0.0;
+  for (const auto &point : curve) {
+    if (point.size == 0 || point.time_sec <= 0.0) {
+      return fit;
+    }
+    const double x = std::log(static_cast<double>(point.size));
+    const double y = std::log(point.time_sec);
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+    syy += y * y;
+  }
+  const double var_x = (n * sxx) - (sx * sx);
+  if (curve.size() < 2 || var_x <= 0.0) {
+    return fit;
+  }
+  const double cov = (n * sxy) - (sx * sy);
+  const double var_y = (n * syy) - (sy * sy);
+  fit.exponent = cov / var_x;
+  fit.r_squared = var_y > 0.0 ? (cov * cov) / (var_x * var_y) : 1.0;
+
+  double best_error = std::numeric_limits<double>::infinity();
+  for (const auto &model : kComplexityModels) {
+    const double error = RelativeFitError(curve, model.growth);
+    if (error < best_error) {
+      best_error = error;
+      fit.model = model.name;
+    }
+  }
+  return fit;
+}
+
+std::vector<std::string> ppc::performance::FormatSizeCurve(const std::string &label,
+                                                           const std::vector<SizePoint> &curve) {
+  std::vector<std::string> lines;
+  for (const auto &point : curve) {
+    const double elements_per_sec = point.time_sec > 0.0 ? static_cast<double>(point.size) / point.time_sec : 0.0;
+    std::stringstream line;
+    line << label << ":size:n=" << point.size << std::fixed << std::setprecision(10) << ",time_sec=" << point.time_sec
+         << std::setprecision(4) << ",elements_per_sec=" << elements_per_sec;
+    lines.push_back(line.str());
+  }
+  const auto fit = FitComplexity(curve);
+  if (!fit.model.empty()) {
+    std::stringstream line;
+    line << label << ":complexity:model=" << fit.model << std::fixed << std::setprecision(4)
+         << ",exponent=" << fit.exponent << ",r2=" << fit.r_squared;
+    lines.push_back(line.str());
+  }
+  return lines;
+}
@@ -1,18 +1,28 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <libenvpp/detail/environment.hpp>
+#include <limits>
 #include <memory>
 #include <ostream>
+#include <random>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <thread>
 #include <vector>
 
+#include "nlohmann/json.hpp"
+#include "performance/include/calibration.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/regression.hpp"
+#include "performance/include/results_writer.hpp"
+#include "performance/include/scaling.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
 
@@ -63,6 +73,20 @@ class FakePerfTask : public TestPerfTask<InType, OutType> {
 
 }  // namespace ppc::test
 
+namespace {
+
+// A new directory for the current test, so that processes started together by mpirun do not remove each other's files
+std::filesystem::path MakeUniqueTempDir() {
+  const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+  const std::string name = "ppc_" + std::string(info->test_suite_name()) + "_" + info->name() + "_" +
+                           std::to_string(std::random_device{}());
+  const auto dir = std::filesystem::temp_directory_path() / name;
+  std::filesystem::create_directories(dir);
+  return dir;
+}
+
+}  // namespace
+
 namespace ppc::performance {
 
 TEST(PerfTests, CheckPerfPipeline) {
@@ -104,6 +128,7 @@ TEST(PerfTests, CheckPerfPipelineUint8tSlowTest) {
 
   PerfAttr perf_attr;
   perf_attr.num_running = 1;
+  perf_attr.num_warmup = 0;
 
   const auto t0 = std::chrono::high_resolution_clock::now();
   perf_attr.current_timer = [&] {
@@ -123,6 +148,7 @@ TEST(PerfTests, SlowPerfRespectsEnvOverride) {
   Perf<std::vector<uint8_t>, uint8_t> perf_analyzer(test_task);
   PerfAttr perf_attr;
   perf_attr.num_running = 1;
+  perf_attr.num_warmup = 0;
   const auto t0 = std::chrono::high_resolution_clock::now();
   perf_attr.current_timer = [&] {
     auto current_time_point = std::chrono::high_resolution_clock::now();
@@ -196,10 +222,12 @@ struct TaskTypeTestCase {
 
 class GetStringTaskTypeTest : public ::testing::TestWithParam<TaskTypeTestCase> {
  protected:
+  std::filesystem::path temp_dir;
   std::string temp_path;
 
   void SetUp() override {
-    temp_path = (std::filesystem::temp_directory_path() / "test_settings.json").string();
+    temp_dir = MakeUniqueTempDir();
+    temp_path = (temp_dir / "test_settings.json").string();
     auto j = ppc::util::InitJSONPtr();
     (*j)["tasks"]["all"] = "ALL";
     (*j)["tasks"]["stl"] = "STL";
@@ -212,7 +240,7 @@ class GetStringTaskTypeTest : public ::testing::TestWithParam<TaskTypeTestCase>
   }
 
   void TearDown() override {
-    std::filesystem::remove(temp_path);
+    std::filesystem::remove_all(temp_dir);
   }
 };
 
@@ -244,13 +272,14 @@ TEST(GetStringTaskTypeStandaloneTest, ExceptionMessageContainsPath) {
 }
 
 TEST(GetStringTaskTypeStandaloneTest, ReturnsUnknownForInvalidEnum) {
-  std::string path = (std::filesystem::temp_directory_path() / "tmp_settings.json").string();
+  const auto dir = MakeUniqueTempDir();
+  std::string path = (dir / "tmp_settings.json").string();
   std::ofstream(path) << R"({"tasks":{"seq":"SEQ"}})";
 
   auto result = GetStringTaskType(TypeOfTask::kUnknown, path);
   EXPECT_EQ(result, "unknown");
 
-  std::filesystem::remove(path);
+  std::filesystem::remove_all(dir);
 }
 
 TEST(GetStringTaskTypeEdgeCases, ThrowsIfFileCannotBeOpened) {
@@ -258,27 +287,30 @@ TEST(GetStringTaskTypeEdgeCases, ThrowsIfFileCannotBeOpened) {
 }
 
 TEST(GetStringTaskTypeEdgeCases, ThrowsIfJsonIsMalformed) {
-  std::string path = (std::filesystem::temp_directory_path() / "bad_json.json").string();
+  const auto dir = MakeUniqueTempDir();
+  std::string path = (dir / "bad_json.json").string();
   std::ofstream(path) << "{ this is not valid json ";
   EXPECT_THROW(GetStringTaskType(TypeOfTask::kSEQ, path), NlohmannJsonParseError);
-  std::filesystem::remove(path);
+  std::filesystem::remove_all(dir);
 }
 
 TEST(GetStringTaskTypeEdgeCases, ThrowsIfJsonValueIsNull) {
-  std::string path = (std::filesystem::temp_directory_path() / "null_value.json").string();
+  const auto dir = MakeUniqueTempDir();
+  std::string path = (dir / "null_value.json").string();
   std::ofstream(path) << R"({"tasks": { "seq": null }})";
 
   EXPECT_THROW(GetStringTaskType(TypeOfTask::kSEQ, path), NlohmannJsonTypeError);
 
-  std::filesystem::remove(path);
+  std::filesystem::remove_all(dir);
 }
 
 TEST(GetStringTaskTypeEdgeCases, ReturnsUnknownIfEnumOutOfRange) {
-  std::string path = (std::filesystem::temp_directory_path() / "ok.json").string();
+  const auto dir = MakeUniqueTempDir();
+  std::string path = (dir / "ok.json").string();
   std::ofstream(path) << R"({"tasks":{"seq":"SEQ"}})";
   auto result = GetStringTaskType(TypeOfTask::kUnknown, path);
   EXPECT_EQ(result, "unknown");
-  std::filesystem::remove(path);
+  std::filesystem::remove_all(dir);
 }
 
 TEST(GetStringTaskStatusTest, HandlesEnabledAndDisabled) {
@@ -371,6 +403,529 @@ TEST(PerfTest, PipelineRunAndTaskRun) {
   EXPECT_GT(res_taskrun.time_sec, 0.0);
 }
 
+TEST(PerfTest, PipelineRunCollectsPerIterationDistribution) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  // Each iteration reads the timer twice: iteration durations are 1, 2, 3, 4 and 10 seconds
+  const std::vector<double> timestamps = {0.0, 1.0, 1.0, 3.0, 3.0, 6.0, 6.0, 10.0, 10.0, 20.0};
+  std::size_t call = 0;
+  PerfAttr attr;
+  attr.num_running = 5;
+  attr.current_timer = [&] { return timestamps[call++]; };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+
+  EXPECT_EQ(res.samples_sec, (std::vector<double>{1.0, 2.0, 3.0, 4.0, 10.0}));
+  EXPECT_DOUBLE_EQ(res.time_sec, 4.0);
+  EXPECT_DOUBLE_EQ(res.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(res.median_sec, 3.0);
+  EXPECT_DOUBLE_EQ(res.p90_sec, 7.6);
+  EXPECT_DOUBLE_EQ(res.max_sec, 10.0);
+  EXPECT_NEAR(res.stddev_sec, std::sqrt(12.5), 1e-12);
+  EXPECT_LE(res.p90_sec, res.p99_sec);
+}
+
+TEST(PerfTest, QuantileHandlesEdgeCases) {
+  EXPECT_DOUBLE_EQ(Quantile({}, 0.5), 0.0);
+  EXPECT_DOUBLE_EQ(Quantile({7.0}, 0.99), 7.0);
+  EXPECT_DOUBLE_EQ(Quantile({1.0, 3.0}, 0.5), 2.0);
+  EXPECT_DOUBLE_EQ(Quantile({1.0, 3.0}, 1.0), 3.0);
+}
+
+TEST(PerfTest, PrintPerfStatisticEmitsDistributionLine) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  attr.current_timer = [&time]() { return time += 0.5; };
+  perf.PipelineRun(attr);
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("distribution_line");
+  const std::string output = ::testing::internal::GetCapturedStdout();
+
+  EXPECT_NE(output.find("distribution_line:pipeline:0.5000000000"), std::string::npos);
+  EXPECT_NE(output.find("distribution_line:pipeline:stats:min=0.5000000000"), std::string::npos);
+  EXPECT_NE(output.find(",n=5"), std::string::npos);
+  EXPECT_NE(output.find("distribution_line:pipeline:stages:validation="), std::string::npos);
+}
+
+class CountingTask : public DummyTask {
+ public:
+  bool RunImpl() override {
+    ++runs;
+    return true;
+  }
+  uint64_t runs = 0;
+};
+
+TEST(PerfTest, WarmupRunsAreExcludedFromSamples) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_warmup = 3;
+  attr.num_running = 2;
+
+  perf.TaskRun(attr);
+
+  EXPECT_EQ(perf.GetPerfResults().samples_sec.size(), 2U);
+  // Warm-up and measured runs plus the final verification pipeline
+  EXPECT_EQ(task_ptr->runs, 6U);
+}
+
+TEST(PerfTest, AdaptiveStopsAtMinRunningForStableTimes) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  attr.current_timer = [&time]() { return time += 1.0; };
+  attr.adaptive = true;
+  attr.min_running = 4;
+  attr.max_running = 100;
+
+  perf.PipelineRun(attr);
+
+  EXPECT_EQ(perf.GetPerfResults().samples_sec.size(), 4U);
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().median_rel_ci, 0.0);
+}
+
+TEST(PerfTest, AdaptiveStopsAtMaxRunningForUnstableTimes) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double call = 0.0;
+  // Every iteration is slower than the previous one, so the median never settles
+  attr.current_timer = [&call]() {
+    call += 1.0;
+    return call * call;
+  };
+  attr.adaptive = true;
+  attr.min_running = 3;
+  attr.max_running = 20;
+  attr.max_time_sec = std::numeric_limits<double>::max();
+
+  perf.PipelineRun(attr);
+
+  EXPECT_EQ(perf.GetPerfResults().samples_sec.size(), 20U);
+  EXPECT_GT(perf.GetPerfResults().median_rel_ci, attr.target_rel_ci);
+}
+
+TEST(PerfTest, AdaptiveRespectsTimeBudgetAndSyncDecision) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double call = 0.0;
+  attr.current_timer = [&call]() {
+    call += 1.0;
+    return call * call;
+  };
+  attr.adaptive = true;
+  attr.min_running = 3;
+  attr.max_running = 20;
+  attr.max_time_sec = 0.0;
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().samples_sec.size(), 3U);
+
+  attr.sync_decision = [](bool /*decision*/) { return false; };
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().samples_sec.size(), 20U);
+}
+
+TEST(PerfTest, CollectsStageTimesPerIteration) {
+  std::vector<uint32_t> in(2000, 1);
+  auto test_task = std::make_shared<ppc::test::TestPerfTask<std::vector<uint32_t>, uint32_t>>(in);
+  Perf<std::vector<uint32_t>, uint32_t> perf(test_task);
+  PerfAttr attr;
+  attr.num_running = 3;
+
+  perf.PipelineRun(attr);
+  const auto pipeline_res = perf.GetPerfResults();
+  ASSERT_EQ(pipeline_res.stage_samples.size(), 3U);
+  EXPECT_GT(pipeline_res.stage_mean.run_sec, 0.0);
+  EXPECT_GE(pipeline_res.stage_mean.validation_sec, 0.0);
+
+  perf.TaskRun(attr);
+  const auto task_run_res = perf.GetPerfResults();
+  ASSERT_EQ(task_run_res.stage_samples.size(), 3U);
+  EXPECT_GT(task_run_res.stage_mean.run_sec, 0.0);
+  EXPECT_DOUBLE_EQ(task_run_res.stage_mean.validation_sec, 0.0);
+  EXPECT_DOUBLE_EQ(task_run_res.stage_mean.postprocessing_sec, 0.0);
+}
+
+TEST(PerfTest, ComputeRankSpreadFindsSlowestRank) {
+  const auto spread = ComputeRankSpread({1.0, 3.0, 2.0, 2.0});
+  EXPECT_DOUBLE_EQ(spread.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(spread.max_sec, 3.0);
+  EXPECT_DOUBLE_EQ(spread.mean_sec, 2.0);
+  EXPECT_DOUBLE_EQ(spread.imbalance, 1.5);
+  EXPECT_EQ(spread.slowest_rank, 1);
+
+  const auto empty = ComputeRankSpread({});
+  EXPECT_DOUBLE_EQ(empty.imbalance, 1.0);
+  EXPECT_DOUBLE_EQ(ComputeRankSpread({0.0, 0.0}).imbalance, 1.0);
+}
+
+TEST(PerfTest, MpiProfileAttributesTrafficToActiveStage) {
+  struct SendingTask : DummyTask {
+    bool RunImpl() override {
+      MpiProfile::Record(MpiRoutine::kBcast, 64, 0.25);
+      return true;
+    }
+  };
+  auto task_ptr = std::make_shared<SendingTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 3;
+  perf.PipelineRun(attr);
+
+  const auto &profile = perf.GetPerfResults().mpi_profile;
+  const auto &run_bcast = profile[static_cast<std::size_t>(ppc::util::ActiveStage::kRun)]
+                                 [static_cast<std::size_t>(MpiRoutine::kBcast)];
+  EXPECT_EQ(run_bcast.calls, 3U);
+  EXPECT_EQ(run_bcast.bytes, 192U);
+  EXPECT_DOUBLE_EQ(run_bcast.time_sec, 0.75);
+  EXPECT_EQ(profile[static_cast<std::size_t>(ppc::util::ActiveStage::kNone)]
+                   [static_cast<std::size_t>(MpiRoutine::kBcast)]
+                       .calls,
+            0U);
+  EXPECT_EQ(GetMpiRoutineName(MpiRoutine::kBcast), "MPI_Bcast");
+  MpiProfile::Reset();
+}
+
+TEST(PerfTest, HwCountersAreOffByDefault) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  perf.PipelineRun(PerfAttr{});
+
+  const auto results = perf.GetPerfResults();
+  EXPECT_FALSE(results.hw_counters.requested);
+  EXPECT_TRUE(results.hw_samples.empty());
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("no_hw");
+  EXPECT_EQ(::testing::internal::GetCapturedStdout().find(":hw:"), std::string::npos);
+}
+
+TEST(PerfTest, HwCountersAreCollectedOrReportedUnavailable) {
+  auto task_ptr = std::make_shared<CountingTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.hw_counters = true;
+  attr.num_elements = 10;
+  perf.TaskRun(attr);
+
+  const auto results = perf.GetPerfResults();
+  EXPECT_TRUE(results.hw_counters.requested);
+  EXPECT_EQ(results.num_elements, 10U);
+  EXPECT_EQ(results.hw_samples.size(), results.samples_sec.size());
+  for (std::size_t i = 0; i < kHwCounterCount; i++) {
+    if (!results.hw_counters.available[i]) {
+      EXPECT_EQ(results.hw_counters.mean[i], 0.0) << GetHwCounterName(static_cast<HwCounter>(i));
+    }
+  }
+  if (results.hw_counters.available[static_cast<std::size_t>(HwCounter::kInstructions)]) {
+    EXPECT_GT(results.hw_counters.mean[static_cast<std::size_t>(HwCounter::kInstructions)], 0.0);
+  }
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("hw_line");
+  EXPECT_NE(::testing::internal::GetCapturedStdout().find("hw_line:task_run:hw:"), std::string::npos);
+}
+
+TEST(PerfTest, PerfResultsToJsonContainsRunContextAndStatistics) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  double time = 0.0;
+  attr.current_timer = [&time]() { return time += 0.5; };
+  attr.num_elements = 1000;
+  perf.PipelineRun(attr);
+
+  const PerfRunInfo info{.test_id = "json_record", .type_of_task = TypeOfTask::kMPI, .num_procs = 4, .num_threads = 2};
+  const auto record = PerfResultsToJson(info, perf.GetPerfResults());
+
+  EXPECT_EQ(record["test_id"], "json_record");
+  EXPECT_EQ(record["type_of_task"], "mpi");
+  EXPECT_EQ(record["type_of_running"], "pipeline");
+  EXPECT_EQ(record["num_procs"], 4);
+  EXPECT_EQ(record["num_threads"], 2);
+  EXPECT_EQ(record["num_elements"], 1000);
+  EXPECT_DOUBLE_EQ(record["median_sec"].get<double>(), 0.5);
+  EXPECT_EQ(record["samples_sec"].size(), 5U);
+  EXPECT_TRUE(record["stages"].contains("run_sec"));
+  EXPECT_FALSE(record.contains("hw_counters"));
+  EXPECT_FALSE(record.contains("ranks"));
+  EXPECT_TRUE(record["host"].contains("name"));
+  EXPECT_TRUE(record.contains("timestamp_unix"));
+}
+
+TEST(PerfTest, AppendPerfResultsWritesJsonLinesAndCsv) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  perf.TaskRun(PerfAttr{});
+  const PerfRunInfo info{.test_id = "append", .type_of_task = TypeOfTask::kSEQ};
+
+  const auto dir = MakeUniqueTempDir();
+  const auto count_lines = [](const std::filesystem::path &path) {
+    std::ifstream file(path);
+    std::string line;
+    std::size_t lines = 0;
+    while (std::getline(file, line)) {
+      lines++;
+    }
+    return lines;
+  };
+
+  const auto json_path = (dir / "results.jsonl").string();
+  AppendPerfResults(json_path, info, perf.GetPerfResults());
+  AppendPerfResults(json_path, info, perf.GetPerfResults());
+  EXPECT_EQ(count_lines(json_path), 2U);
+
+  const auto csv_path = (dir / "results.csv").string();
+  AppendPerfResults(csv_path, info, perf.GetPerfResults());
+  AppendPerfResults(csv_path, info, perf.GetPerfResults());
+  EXPECT_EQ(count_lines(csv_path), 3U);
+  std::ifstream csv(csv_path);
+  std::string header;
+  std::getline(csv, header);
+  EXPECT_EQ(header, PerfResultsCsvHeader());
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(PerfTest, MannWhitneyDetectsShiftedSamples) {
+  const std::vector<double> slow = {6.0, 7.0, 8.0, 9.0, 10.0};
+  const std::vector<double> fast = {1.0, 2.0, 3.0, 4.0, 5.0};
+
+  const auto greater = MannWhitneyGreater(slow, fast);
+  EXPECT_DOUBLE_EQ(greater.u, 25.0);
+  EXPECT_LT(greater.p_value, 0.01);
+
+  EXPECT_GT(MannWhitneyGreater(fast, slow).p_value, 0.99);
+  EXPECT_GE(MannWhitneyGreater(fast, fast).p_value, 0.5);
+  EXPECT_DOUBLE_EQ(MannWhitneyGreater({}, fast).p_value, 1.0);
+}
+
+TEST(PerfTest, CompareWithBaselineRespectsMargin) {
+  const std::vector<double> baseline = {1.00, 1.01, 0.99, 1.02, 0.98, 1.00, 1.01};
+  const auto scaled = [&baseline](double factor) {
+    std::vector<double> samples;
+    for (const double value : baseline) {
+      samples.push_back(value * factor);
+    }
+    return samples;
+  };
+
+  const auto slower = CompareWithBaseline(scaled(1.15), baseline, {.margin = 0.1});
+  EXPECT_TRUE(slower.has_baseline);
+  EXPECT_TRUE(slower.regressed);
+  EXPECT_NEAR(slower.ratio, 1.15, 1e-9);
+
+  EXPECT_FALSE(CompareWithBaseline(scaled(1.05), baseline, {.margin = 0.1}).regressed);
+  EXPECT_FALSE(CompareWithBaseline(scaled(0.5), baseline, {.margin = 0.1}).regressed);
+  EXPECT_FALSE(CompareWithBaseline(scaled(1.15), {}, {.margin = 0.1}).has_baseline);
+}
+
+TEST(PerfTest, PrintPerfStatisticFailsOnBaselineRegression) {
+  const auto dir = MakeUniqueTempDir();
+  const auto baseline_path = (dir / "baseline.jsonl").string();
+
+  const auto run = [](double iteration_sec) {
+    auto task_ptr = std::make_shared<DummyTask>();
+    auto perf = std::make_unique<Perf<int, int>>(task_ptr);
+    PerfAttr attr;
+    double time = 0.0;
+    int calls = 0;
+    // Every iteration is 1% slower than the previous one so that the samples are not all tied
+    attr.current_timer = [&time, &calls, iteration_sec]() {
+      if (calls++ % 2 == 1) {
+        time += iteration_sec * (1.0 + (0.01 * calls));
+      }
+      return time;
+    };
+    perf->PipelineRun(attr);
+    return perf;
+  };
+
+  const auto baseline_perf = run(0.1);
+  AppendPerfResults(baseline_path, {.test_id = "baseline_gate"}, baseline_perf->GetPerfResults());
+  EXPECT_EQ(LoadBaselineSamples(baseline_path, "baseline_gate", "pipeline").size(), 5U);
+  EXPECT_TRUE(LoadBaselineSamples(baseline_path, "baseline_gate", "task_run").empty());
+
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_BASELINE_FILE", baseline_path);
+  ::testing::internal::CaptureStdout();
+  EXPECT_NO_THROW(run(0.1)->PrintPerfStatistic("baseline_gate"));
+  EXPECT_THROW(run(0.2)->PrintPerfStatistic("baseline_gate"), std::runtime_error);
+  EXPECT_NO_THROW(run(0.2)->PrintPerfStatistic("not_in_baseline"));
+  const std::string output = ::testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find("baseline_gate:pipeline:baseline:median="), std::string::npos);
+  EXPECT_NE(output.find("not_in_baseline:pipeline:baseline:missing"), std::string::npos);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(PerfTest, ComputeThroughputUsesRunTime) {
+  PerfResults results;
+  results.stage_mean.run_sec = 0.5;
+  results.work_units = {.bytes_read = 3'000'000'000, .bytes_written = 1'000'000'000, .operations = 250'000'000};
+  ComputeThroughput(results);
+  EXPECT_DOUBLE_EQ(results.bandwidth_gbs, 8.0);
+  EXPECT_DOUBLE_EQ(results.elements_per_sec, 5e8);
+
+  results.stage_mean.run_sec = 0.0;
+  ComputeThroughput(results);
+  EXPECT_DOUBLE_EQ(results.bandwidth_gbs, 0.0);
+}
+
+TEST(PerfTest, ReportsThroughputOfTasksWithWorkUnits) {
+  struct StreamingTask : DummyTask {
+    bool RunImpl() override {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return true;
+    }
+    ppc::task::WorkUnits GetWorkUnits() override {
+      return {.bytes_read = 8000, .bytes_written = 8, .operations = 1000};
+    }
+  };
+  auto task_ptr = std::make_shared<StreamingTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.num_warmup = 0;
+  attr.peak_bandwidth_gbs = 10.0;
+  perf.TaskRun(attr);
+
+  const auto results = perf.GetPerfResults();
+  EXPECT_EQ(results.work_units.operations, 1000U);
+  EXPECT_EQ(results.num_elements, 1000U);
+  EXPECT_GT(results.bandwidth_gbs, 0.0);
+  EXPECT_GT(results.elements_per_sec, 0.0);
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("throughput_line");
+  const std::string output = ::testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find("throughput_line:task_run:throughput:bytes_read=8000,bytes_written=8,operations=1000,gbs="),
+            std::string::npos);
+  EXPECT_NE(output.find(",peak_pct="), std::string::npos);
+}
+
+TEST(PerfTest, OmitsThroughputWithoutWorkUnits) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  perf.PipelineRun(PerfAttr{});
+
+  ::testing::internal::CaptureStdout();
+  perf.PrintPerfStatistic("no_throughput");
+  EXPECT_EQ(::testing::internal::GetCapturedStdout().find(":throughput:"), std::string::npos);
+}
+
+TEST(PerfTest, MeasureStreamReportsAllKernels) {
+  const auto result = MeasureStream(1, 1 << 16, 2);
+  EXPECT_EQ(result.threads, 1);
+  EXPECT_GT(result.copy_gbs, 0.0);
+  EXPECT_GT(result.scale_gbs, 0.0);
+  EXPECT_GT(result.add_gbs, 0.0);
+  EXPECT_GT(result.triad_gbs, 0.0);
+}
+
+TEST(PerfTest, CalibrationRoundTripsThroughJson) {
+  Calibration calibration;
+  calibration.stream = {{.threads = 1, .copy_gbs = 10, .scale_gbs = 9, .add_gbs = 11, .triad_gbs = 12},
+                        {.threads = 4, .copy_gbs = 30, .scale_gbs = 29, .add_gbs = 31, .triad_gbs = 32}};
+  calibration.ping_pong = {{.bytes = 8, .latency_us = 0.5, .bandwidth_gbs = 0.016}};
+
+  const auto restored = CalibrationFromJson(nlohmann::json::parse(CalibrationToJson(calibration).dump()));
+  ASSERT_EQ(restored.stream.size(), 2U);
+  EXPECT_EQ(restored.stream[1].threads, 4);
+  EXPECT_DOUBLE_EQ(restored.stream[1].triad_gbs, 32.0);
+  ASSERT_EQ(restored.ping_pong.size(), 1U);
+  EXPECT_EQ(restored.ping_pong[0].bytes, 8U);
+  EXPECT_DOUBLE_EQ(restored.ping_pong[0].latency_us, 0.5);
+  EXPECT_THROW(CalibrationFromJson(nlohmann::json::object()), nlohmann::json::exception);
+}
+
+TEST(PerfTest, CalibrationPeakBandwidthUsesClosestLowerThreadCount) {
+  Calibration calibration;
+  EXPECT_DOUBLE_EQ(calibration.PeakBandwidthGbs(4), 0.0);
+
+  calibration.stream = {
+      {.threads = 2, .triad_gbs = 12}, {.threads = 4, .triad_gbs = 20}, {.threads = 6, .triad_gbs = 24}};
+  EXPECT_DOUBLE_EQ(calibration.PeakBandwidthGbs(1), 12.0);
+  EXPECT_DOUBLE_EQ(calibration.PeakBandwidthGbs(5), 20.0);
+  EXPECT_DOUBLE_EQ(calibration.PeakBandwidthGbs(64), 24.0);
+}
+
+TEST(PerfTest, CalibrationCacheSharesParentOfPerTestDir) {
+  const auto dir = std::filesystem::temp_directory_path() / "ppc_calibration_test" / "per_test";
+  env::detail::set_scoped_environment_variable scoped("PPC_TEST_TMPDIR", dir.string());
+  const std::filesystem::path path = GetCalibrationCachePath(2, 8);
+  EXPECT_EQ(path.parent_path(), dir.parent_path());
+  EXPECT_NE(path.filename().string().find("_np2_t8"), std::string::npos);
+  EXPECT_NE(path, std::filesystem::path(GetCalibrationCachePath(4, 8)));
+}
+
+TEST(PerfTest, ScalingKeyPairsImplementationsOfOneTask) {
+  EXPECT_EQ(GetScalingKey("nesterov_a_test_task_threads_omp_enabled", "pipeline"),
+            GetScalingKey("nesterov_a_test_task_threads_seq_enabled", "pipeline"));
+  EXPECT_EQ(GetScalingKey("nesterov_a_test_task_threads_omp_enabled", "task_run"),
+            "nesterov_a_test_task_threads:task_run");
+}
+
+TEST(PerfTest, ScalingReportWaitsForSequentialReference) {
+  ScalingReport report;
+  EXPECT_TRUE(report.AddPoint("task:pipeline", {.label = "omp_t2", .threads = 2, .workers = 2, .time_sec = 0.5})
+                  .empty());
+
+  const auto held_back = report.AddReference("task:pipeline", 1.0);
+  ASSERT_EQ(held_back.size(), 1U);
+  EXPECT_EQ(held_back[0], "omp_t2:scaling:threads=2,workers=2,time_sec=0.5000000000,speedup=2.0000,efficiency=1.0000");
+
+  const auto immediate =
+      report.AddPoint("task:pipeline", {.label = "omp_t4", .threads = 4, .workers = 4, .time_sec = 0.5});
+  ASSERT_EQ(immediate.size(), 1U);
+  EXPECT_NE(immediate[0].find("speedup=2.0000,efficiency=0.5000"), std::string::npos);
+  EXPECT_TRUE(report.AddReference("task:pipeline", 1.0).empty());
+}
+
+TEST(PerfTest, ScalingReportHandsOutPointsWithoutReference) {
+  ScalingReport report;
+  EXPECT_TRUE(report.AddPoint("filtered:pipeline", {.label = "tbb_t2", .threads = 2, .workers = 2, .time_sec = 0.25})
+                  .empty());
+
+  const auto pending = report.TakePending();
+  ASSERT_EQ(pending.size(), 1U);
+  EXPECT_EQ(pending[0], "tbb_t2:scaling:threads=2,workers=2,time_sec=0.2500000000,speedup=n/a,efficiency=n/a");
+  EXPECT_TRUE(report.TakePending().empty());
+  EXPECT_TRUE(report.AddReference("filtered:pipeline", 1.0).empty());
+}
+
+TEST(PerfTest, FitComplexityRecognizesGrowthModels) {
+  std::vector<SizePoint> linear;
+  std::vector<SizePoint> quadratic;
+  for (const std::size_t size : {1000, 2000, 4000, 8000}) {
+    const auto n = static_cast<double>(size);
+    linear.push_back({.size = size, .time_sec = 2e-9 * n});
+    quadratic.push_back({.size = size, .time_sec = 1e-12 * n * n});
+  }
+
+  const auto linear_fit = FitComplexity(linear);
+  EXPECT_EQ(linear_fit.model, "O(n)");
+  EXPECT_NEAR(linear_fit.exponent, 1.0, 1e-9);
+  EXPECT_NEAR(linear_fit.r_squared, 1.0, 1e-9);
+  EXPECT_EQ(FitComplexity(quadratic).model, "O(n^2)");
+  EXPECT_TRUE(FitComplexity({linear.front()}).model.empty());
+}
+
+TEST(PerfTest, FormatSizeCurveReportsThroughputAndComplexity) {
+  const std::vector<SizePoint> curve = {{.size = 1000, .time_sec = 1e-6}, {.size = 4000, .time_sec = 4e-6}};
+  const auto lines = FormatSizeCurve("case:pipeline", curve);
+  ASSERT_EQ(lines.size(), 3U);
+  EXPECT_EQ(lines[0], "case:pipeline:size:n=1000,time_sec=0.0000010000,elements_per_sec=1000000000.0000");
+  EXPECT_EQ(lines[2], "case:pipeline:complexity:model=O(n),exponent=1.0000,r2=1.0000");
+}
+
 TEST(PerfTest, PrintPerfStatisticThrowsOnNone) {
   {
     auto task_ptr = std::make_shared<DummyTask>();
@@ -8,14 +8,17 @@
 #include <cstdlib>
 #include <exception>
 #include <format>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "oneapi/tbb/global_control.h"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
@@ -124,6 +127,79 @@ bool HasFlag(int argc, char **argv, std::string_view flag) {
   return false;
 }
 
+// Offset that maps the trace clock of this process to the one of rank 0, estimated from the round trip with the
+// smallest delay (Cristian's algorithm)
+int64_t EstimateTraceClockOffsetNs(int rank, int size) {
+  constexpr int kRounds = 8;
+  int64_t offset = 0;
+  int64_t best_delay = -1;
+  for (int peer = 1; peer < size; peer++) {
+    for (int round = 0; round < kRounds; round++) {
+      if (rank == 0) {
+        int64_t request = 0;
+        MPI_Recv(&request, 1, MPI_INT64_T, peer, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        const int64_t root_time = ppc::util::Tracer::NowNs();
+        MPI_Send(&root_time, 1, MPI_INT64_T, peer, 0, MPI_COMM_WORLD);
+      } else if (rank == peer) {
+        int64_t root_time = 0;
+        const int64_t send_time = ppc::util::Tracer::NowNs();
+        MPI_Send(&send_time, 1, MPI_INT64_T, 0, 0, MPI_COMM_WORLD);
+        MPI_Recv(&root_time, 1, MPI_INT64_T, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        const int64_t recv_time = ppc::util::Tracer::NowNs();
+        if (best_delay < 0 || recv_time - send_time < best_delay) {
+          best_delay = recv_time - send_time;
+          offset = root_time - ((send_time + recv_time) / 2);
+        }
+      }
+    }
+  }
+  return offset;
+}
+
+// Merge the spans of all processes on rank 0 into one Chrome trace file
+void WriteTrace(const std::string &path) {
+  int rank = -1;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const int64_t offset = EstimateTraceClockOffsetNs(rank, size);
+  const std::string events = ppc::util::Tracer::SerializeEvents(rank, offset);
+  const int length = static_cast<int>(events.size());
+  std::vector<int> lengths(rank == 0 ? size : 0);
+  MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+  std::vector<int> displs(lengths.size());
+  std::string gathered;
+  if (rank == 0) {
+    for (std::size_t i = 1; i < lengths.size(); i++) {
+      displs[i] = displs[i - 1] + lengths[i - 1];
+    }
+    gathered.resize(static_cast<std::size_t>(displs.back() + lengths.back()));
+  }
+  MPI_Gatherv(events.data(), length, MPI_CHAR, gathered.data(), lengths.data(), displs.data(), MPI_CHAR, 0,
+              MPI_COMM_WORLD);
+  if (rank != 0) {
+    return;
+  }
+
+  std::vector<std::string> event_arrays;
+  event_arrays.reserve(lengths.size());
+  for (std::size_t i = 0; i < lengths.size(); i++) {
+    event_arrays.push_back(gathered.substr(static_cast<std::size_t>(displs[i]), static_cast<std::size_t>(lengths[i])));
+  }
+  ppc::util::Tracer::WriteChromeTrace(path, event_arrays);
+}
+
+// A trace that cannot be written is reported, but it neither replaces the result of the tests nor skips MPI_Finalize
+void WriteTraceSafely(const std::function<void()> &write) {
+  try {
+    write();
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] Failed to write the trace: {}", e.what()) << '\n';
+  }
+}
+
 int RunAllTestsSafely() {
   try {
     return RunAllTests();
@@ -137,6 +213,10 @@ int RunAllTestsSafely() {
     return EXIT_FAILURE;
   }
 }
+// A thread-count sweep narrows the TBB limit per run, so the process-wide limit has to admit its largest count
+int GetTbbParallelism() {
+  return ppc::util::GetMaxNumThreads();
+}
 }  // namespace
 
 int Init(int argc, char **argv) {
@@ -148,7 +228,7 @@ int Init(int argc, char **argv) {
   }
 
   // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, GetTbbParallelism());
 
   ::testing::InitGoogleTest(&argc, argv);
 
@@ -166,8 +246,18 @@ int Init(int argc, char **argv) {
   }
   listeners.Append(new UnreadMessagesDetector());
 
+  const auto trace_file = ppc::util::GetTraceFile();
+  if (!trace_file.empty()) {
+    ppc::util::Tracer::Enable();
+  }
+
   const int status = RunAllTestsSafely();
 
+  if (!trace_file.empty()) {
+    ppc::util::Tracer::Disable();
+    WriteTraceSafely([&] { WriteTrace(trace_file); });
+  }
+
   const int finalize_res = MPI_Finalize();
   if (finalize_res != MPI_SUCCESS) {
     std::cerr << std::format("[  ERROR  ] MPI_Finalize failed with code {}", finalize_res) << '\n';
@@ -179,10 +269,20 @@ int Init(int argc, char **argv) {
 
 int SimpleInit(int argc, char **argv) {
   // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, GetTbbParallelism());
 
   testing::InitGoogleTest(&argc, argv);
-  return RunAllTests();
+
+  const auto trace_file = ppc::util::GetTraceFile();
+  if (trace_file.empty()) {
+    return RunAllTests();
+  }
+  ppc::util::Tracer::Enable();
+  const int status = RunAllTests();
+  ppc::util::Tracer::Disable();
+  WriteTraceSafely(
+      [&] { ppc::util::Tracer::WriteChromeTrace(trace_file, {ppc::util::Tracer::SerializeEvents(0, 0)}); });
+  return status;
 }
 
 }  // namespace ppc::runners
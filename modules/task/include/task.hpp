@@ -13,6 +13,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <util/include/trace.hpp>
 #include <util/include/util.hpp>
 #include <utility>
 
@@ -98,6 +99,57 @@ inline std::string GetStringTaskType(TypeOfTask type_of_task, const std::string
 
 enum class StateOfTesting : uint8_t { kFunc, kPerf };
 
+/// @brief Describes which processes of an MPI job hold the task input.
+/// @details Declared by a task through GetStaticInputResidency() and honoured by the test harness, which generates
+/// the input only where the task needs it.
+enum class InputResidency : uint8_t {
+  /// Every process receives the full input
+  kReplicated,
+  /// Only rank 0 receives the input; the other ranks get a default-constructed one
+  kRootOnly,
+  /// Every process receives only its own part of the input
+  kDistributed
+};
+
+/// @brief Input of the calling process for a task with @p residency, as the test harness hands it over.
+/// @details Without MPI the process counts as rank 0 of one.
+/// @param generate Callable returning the full input; it is only called on processes that hold it, so ranks other than
+/// 0 of a root-only task never build the input and get a default-constructed one.
+/// @param generate_of_rank Callable as InType(int rank, int num_ranks) returning the part of one process.
+template <typename InType, typename Generate, typename GenerateOfRank>
+InType GetRankInputData(InputResidency residency, const Generate &generate, const GenerateOfRank &generate_of_rank) {
+  if (residency == InputResidency::kReplicated) {
+    return generate();
+  }
+  const int rank = ppc::util::GetMPIRank();
+  if (residency == InputResidency::kRootOnly) {
+    return rank == 0 ? generate() : InType{};
+  }
+  return generate_of_rank(rank, ppc::util::GetMPISize());
+}
+
+/// @brief Wall time spent in each pipeline stage during its latest call, in seconds.
+struct StageTimes {
+  /// @brief Time spent in ValidationImpl().
+  double validation_sec = 0.0;
+  /// @brief Time spent in PreProcessingImpl().
+  double preprocessing_sec = 0.0;
+  /// @brief Time spent in RunImpl().
+  double run_sec = 0.0;
+  /// @brief Time spent in PostProcessingImpl().
+  double postprocessing_sec = 0.0;
+};
+
+/// @brief Amount of work one Run() does for the current input, used to derive throughput in performance tests.
+struct WorkUnits {
+  /// @brief Bytes read from memory.
+  uint64_t bytes_read = 0;
+  /// @brief Bytes written to memory.
+  uint64_t bytes_written = 0;
+  /// @brief Processed elements or performed operations.
+  uint64_t operations = 0;
+};
+
 template <typename InType, typename OutType>
 /// @brief Base abstract class representing a generic task with a defined pipeline.
 /// @tparam InType Input data type.
@@ -113,7 +165,8 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Validation should be called before preprocessing");
     }
-    return ValidationImpl();
+    return TimeStage(ppc::util::ActiveStage::kValidation, stage_times_.validation_sec,
+                     [this] { return ValidationImpl(); });
   }
 
   /// @brief Performs preprocessing on the input data.
@@ -128,7 +181,8 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PreProcessingImpl();
+    return TimeStage(ppc::util::ActiveStage::kPreProcessing, stage_times_.preprocessing_sec,
+                     [this] { return PreProcessingImpl(); });
   }
 
   /// @brief Executes the main logic of the task.
@@ -140,7 +194,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Run should be called after preprocessing");
     }
-    return RunImpl();
+    return TimeStage(ppc::util::ActiveStage::kRun, stage_times_.run_sec, [this] { return RunImpl(); });
   }
 
   /// @brief Performs postprocessing on the output data.
@@ -155,7 +209,21 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PostProcessingImpl();
+    return TimeStage(ppc::util::ActiveStage::kPostProcessing, stage_times_.postprocessing_sec,
+                     [this] { return PostProcessingImpl(); });
+  }
+
+  /// @brief Returns the time spent in each stage during its latest call.
+  /// @return Per-stage wall times in seconds.
+  [[nodiscard]] const StageTimes &GetStageTimes() const {
+    return stage_times_;
+  }
+
+  /// @brief Reports the work done by one Run() for the current input.
+  /// @details Optional; the default reports nothing, which disables throughput metrics.
+  /// @return Bytes read, bytes written and operations of one Run().
+  virtual WorkUnits GetWorkUnits() {
+    return {};
   }
 
   /// @brief Returns the current testing mode.
@@ -188,6 +256,14 @@ class Task {
     return TypeOfTask::kUnknown;
   }
 
+  /// @brief Returns which processes receive the input.
+  /// @details Tasks that distribute the input themselves redeclare it to return kRootOnly, so that the other ranks
+  /// never hold a copy of the full input.
+  /// @return Static input residency (default: kReplicated).
+  static constexpr InputResidency GetStaticInputResidency() {
+    return InputResidency::kReplicated;
+  }
+
   /// @brief Returns a reference to the input data.
   /// @return Reference to the task's input data.
   InType &GetInput() {
@@ -255,12 +331,35 @@ class Task {
   virtual bool PostProcessingImpl() = 0;
 
  private:
+  /// @brief Calls a stage implementation, publishes it as the active stage, traces it and stores its wall time.
+  template <typename StageImpl>
+  static bool TimeStage(ppc::util::ActiveStage stage, double &stage_sec, StageImpl stage_impl) {
+    struct ActiveStageScope {
+      explicit ActiveStageScope(ppc::util::ActiveStage stage) {
+        ppc::util::ActiveStageTracker::Set(stage);
+      }
+      ~ActiveStageScope() {
+        ppc::util::ActiveStageTracker::Set(ppc::util::ActiveStage::kNone);
+      }
+      ActiveStageScope(const ActiveStageScope &) = delete;
+      ActiveStageScope &operator=(const ActiveStageScope &) = delete;
+    } const active_stage_scope(stage);
+    const ppc::util::TraceSpan trace_span(ppc::util::GetActiveStageName(stage), "task");
+    const auto begin = std::chrono::high_resolution_clock::now();
+    const bool result = stage_impl();
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - begin).count();
+    stage_sec = static_cast<double>(duration) * 1e-9;
+    return result;
+  }
+
   InType input_{};
   OutType output_{};
   StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  StageTimes stage_times_;
   enum class PipelineStage : uint8_t {
     kNone,
     kValidation,
@@ -278,13 +377,16 @@ template <typename InType, typename OutType>
 using TaskPtr = std::shared_ptr<Task<InType, OutType>>;
 
 /// @brief Constructs and returns a shared pointer to a task with the given input.
+/// @details The input is moved into the task constructor. A task that takes its input by value and moves it into
+/// GetInput() therefore receives a temporary input without any copy. Inputs too large to copy even once can be shared
+/// by choosing an InType such as std::shared_ptr<const T>.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Shared a pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::shared_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_shared<TaskType>(in);
+std::shared_ptr<TaskType> TaskGetter(InType in) {
+  return std::make_shared<TaskType>(std::move(in));
 }
 
 }  // namespace ppc::task
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <libenvpp/env.hpp>
 #include <memory>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -17,6 +18,7 @@
 
 #include "runners/include/runners.hpp"
 #include "task/include/task.hpp"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 using ppc::task::StateOfTesting;
@@ -24,14 +26,22 @@ using ppc::task::StatusOfTask;
 using ppc::task::Task;
 using ppc::task::TypeOfTask;
 
+// File in the temporary directory that is removed when it goes out of scope. The name gets a random prefix, so that
+// processes running the same test under mpirun never share the file
 class ScopedFile {
  public:
-  explicit ScopedFile(std::string path) : path_(std::move(path)) {}
+  explicit ScopedFile(const std::string &name)
+      : path_((std::filesystem::temp_directory_path() / (std::to_string(std::random_device{}()) + "_" + name))
+                  .string()) {}
   ~ScopedFile() {
     std::error_code ec;
     std::filesystem::remove(path_, ec);
   }
 
+  [[nodiscard]] const std::string &Path() const {
+    return path_;
+  }
+
  private:
   std::string path_;
 };
@@ -77,6 +87,17 @@ class FakeSlowTask : public TestTask<InType, OutType> {
   }
 };
 
+template <typename InType, typename OutType>
+class FakeSleepyRunTask : public TestTask<InType, OutType> {
+ public:
+  explicit FakeSleepyRunTask(const InType &in) : TestTask<InType, OutType>(in) {}
+
+  bool RunImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return TestTask<InType, OutType>::RunImpl();
+  }
+};
+
 }  // namespace ppc::test
 
 TEST(TaskTests, CheckInt32t) {
@@ -108,6 +129,115 @@ TEST(TaskTests, SlowTaskRespectsEnvOverride) {
   EXPECT_NO_THROW(test_task.PostProcessing());
 }
 
+TEST(TaskTests, RecordsStageTimes) {
+  std::vector<int32_t> in(20, 1);
+  ppc::test::FakeSleepyRunTask<std::vector<int32_t>, int32_t> test_task(in);
+  EXPECT_DOUBLE_EQ(test_task.GetStageTimes().run_sec, 0.0);
+  test_task.Validation();
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  const auto &stage_times = test_task.GetStageTimes();
+  EXPECT_GE(stage_times.run_sec, 0.02);
+  EXPECT_GE(stage_times.validation_sec, 0.0);
+  EXPECT_LT(stage_times.postprocessing_sec, stage_times.run_sec);
+}
+
+TEST(TaskTests, PublishesActiveStage) {
+  struct StageProbeTask : Task<int, int> {
+    ppc::util::ActiveStage seen_in_run = ppc::util::ActiveStage::kNone;
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      seen_in_run = ppc::util::ActiveStageTracker::Get();
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  } task;
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  EXPECT_EQ(task.seen_in_run, ppc::util::ActiveStage::kRun);
+  EXPECT_EQ(ppc::util::ActiveStageTracker::Get(), ppc::util::ActiveStage::kNone);
+}
+
+TEST(TaskTests, TracesEveryStage) {
+  ppc::util::Tracer::Clear();
+  ppc::util::Tracer::Enable();
+  {
+    std::vector<int32_t> in(20, 1);
+    ppc::test::TestTask<std::vector<int32_t>, int32_t> test_task(in);
+    test_task.Validation();
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+  }
+  ppc::util::Tracer::Disable();
+  EXPECT_EQ(ppc::util::Tracer::Size(), 4U);
+  const auto events = ppc::util::Tracer::SerializeEvents(0, 0);
+  for (const auto *stage : {"\"validation\"", "\"preprocessing\"", "\"run\"", "\"postprocessing\""}) {
+    EXPECT_NE(events.find(stage), std::string::npos) << stage;
+  }
+  ppc::util::Tracer::Clear();
+}
+
+TEST(TaskTests, TaskGetterMovesInputIntoTask) {
+  struct MovingTask : ppc::test::TestTask<std::vector<int32_t>, int32_t> {
+    explicit MovingTask(std::vector<int32_t> in) : ppc::test::TestTask<std::vector<int32_t>, int32_t>({}) {
+      this->GetInput() = std::move(in);
+    }
+  };
+  std::vector<int32_t> in(1000, 1);
+  const int32_t *data = in.data();
+  auto task = ppc::task::TaskGetter<MovingTask, std::vector<int32_t>>(std::move(in));
+  EXPECT_EQ(task->GetInput().data(), data);
+
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+  EXPECT_EQ(task->GetOutput(), 1000);
+}
+
+TEST(TaskTests, InputResidencyIsReplicatedUnlessRedeclared) {
+  struct RootOnlyTask : ppc::test::TestTask<std::vector<int32_t>, int32_t> {
+    using ppc::test::TestTask<std::vector<int32_t>, int32_t>::TestTask;
+    static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+      return ppc::task::InputResidency::kRootOnly;
+    }
+  };
+  EXPECT_EQ((ppc::test::TestTask<std::vector<int32_t>, int32_t>::GetStaticInputResidency()),
+            ppc::task::InputResidency::kReplicated);
+  EXPECT_EQ(RootOnlyTask::GetStaticInputResidency(), ppc::task::InputResidency::kRootOnly);
+}
+
+TEST(TaskTests, GetRankInputDataOnASingleProcess) {
+  if (ppc::util::GetMPISize() != 1) {
+    GTEST_SKIP() << "The expected inputs are those of a single process";
+  }
+  int generated = 0;
+  const auto generate = [&] {
+    generated++;
+    return std::vector<int32_t>{1, 2, 3};
+  };
+  const auto generate_of_rank = [](int rank, int num_ranks) { return std::vector<int32_t>{rank, num_ranks}; };
+
+  using ppc::task::GetRankInputData;
+  using ppc::task::InputResidency;
+  EXPECT_EQ(GetRankInputData<std::vector<int32_t>>(InputResidency::kReplicated, generate, generate_of_rank).size(), 3U);
+  EXPECT_EQ(GetRankInputData<std::vector<int32_t>>(InputResidency::kRootOnly, generate, generate_of_rank).size(), 3U);
+  EXPECT_EQ(GetRankInputData<std::vector<int32_t>>(InputResidency::kDistributed, generate, generate_of_rank),
+            (std::vector<int32_t>{0, 1}));
+  EXPECT_EQ(generated, 2);
+}
+
 TEST(TaskTests, CheckValidateFunc) {
   std::vector<int32_t> in;
   ppc::test::TestTask<std::vector<int32_t>, int32_t> test_task(in);
@@ -171,8 +301,8 @@ TEST(TaskTest, GetStringTaskTypeInvalidFileThrows) {
 }
 
 TEST(TaskTest, GetStringTaskTypeUnknownTypeWithValidFile) {
-  std::string path = "settings_valid.json";
-  ScopedFile cleaner(path);
+  const ScopedFile settings("settings_valid.json");
+  const std::string &path = settings.Path();
   std::ofstream file(path);
   file
       << R"({"tasks": {"all": "enabled", "stl": "enabled", "omp": "enabled", "mpi": "enabled", "tbb": "enabled", "seq": "enabled"}})";
@@ -181,8 +311,8 @@ TEST(TaskTest, GetStringTaskTypeUnknownTypeWithValidFile) {
 }
 
 TEST(TaskTest, GetStringTaskTypeThrowsOnBadJSON) {
-  std::string path = "bad_settings.json";
-  ScopedFile cleaner(path);
+  const ScopedFile settings("bad_settings.json");
+  const std::string &path = settings.Path();
   std::ofstream file(path);
   file << "{";
   file.close();
@@ -190,8 +320,8 @@ TEST(TaskTest, GetStringTaskTypeThrowsOnBadJSON) {
 }
 
 TEST(TaskTest, GetStringTaskTypeEachTypeWithValidFile) {
-  std::string path = "settings_valid_all.json";
-  ScopedFile cleaner(path);
+  const ScopedFile settings("settings_valid_all.json");
+  const std::string &path = settings.Path();
   std::ofstream file(path);
   file
       << R"({"tasks": {"all": "enabled", "stl": "enabled", "omp": "enabled", "mpi": "enabled", "tbb": "enabled", "seq": "enabled"}})";
@@ -206,8 +336,8 @@ TEST(TaskTest, GetStringTaskTypeEachTypeWithValidFile) {
 }
 
 TEST(TaskTest, GetStringTaskTypeReturnsUnknownOnDefault) {
-  std::string path = "settings_valid_unknown.json";
-  ScopedFile cleaner(path);
+  const ScopedFile settings("settings_valid_unknown.json");
+  const std::string &path = settings.Path();
   std::ofstream file(path);
   file << R"({"tasks": {"all": "enabled"}})";
   file.close();
@@ -217,8 +347,8 @@ TEST(TaskTest, GetStringTaskTypeReturnsUnknownOnDefault) {
 }
 
 TEST(TaskTest, GetStringTaskTypeThrowsIfKeyMissing) {
-  std::string path = "settings_partial.json";
-  ScopedFile cleaner(path);
+  const ScopedFile settings("settings_partial.json");
+  const std::string &path = settings.Path();
   std::ofstream file(path);
   file << R"({"tasks": {"all": "enabled"}})";
   file.close();
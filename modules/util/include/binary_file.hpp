@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "util/include/partition.hpp"
+
+namespace ppc::util {
+
+/// @brief Integer type of the dimensions stored at the start of a binary data file.
+enum class BinaryHeaderType : uint8_t {
+  /// 32-bit signed integers
+  kInt32,
+  /// 64-bit unsigned integers, i.e. size_t on 64-bit platforms
+  kUInt64
+};
+
+/// @brief Layout of a binary data file: the dimensions followed by the elements in row-major order.
+struct BinaryFileHeader {
+  /// @brief Dimensions in file order; the first one is the number of rows.
+  std::vector<std::size_t> dims;
+  /// @brief Offset of the first element in bytes.
+  std::size_t data_offset = 0;
+
+  /// @brief Number of elements in one row, the product of all dimensions but the first.
+  [[nodiscard]] std::size_t RowSize() const;
+};
+
+/// @brief Reads the header of a binary data file.
+/// @param path Path to the file.
+/// @param type Integer type of the dimensions.
+/// @param num_dims Number of dimensions, e.g. 1 for a vector and 2 for a matrix.
+/// @throws std::runtime_error If the file cannot be read or a dimension is not positive.
+BinaryFileHeader ReadBinaryFileHeader(const std::string &path, BinaryHeaderType type, std::size_t num_dims);
+
+/// @brief Reads the header of a binary data file like ReadBinaryFileHeader(), on all processes together.
+/// @details Collective over MPI_COMM_WORLD if MPI is initialized: if any process fails to read the header, all of them
+/// throw, so none is left waiting in the collective read that follows.
+/// @throws std::runtime_error If the header cannot be read on some process.
+BinaryFileHeader ReadBinaryFileHeaderCollective(const std::string &path, BinaryHeaderType type, std::size_t num_dims);
+
+/// @brief Reads @p buffer.size() bytes of a file starting at @p offset.
+/// @details Collective over MPI_COMM_WORLD if MPI is initialized: every process calls it with its own range, and the
+/// ranges are read with MPI_File_read_at_all, so the MPI library can merge them into few large requests. Without MPI
+/// the range is read with std::ifstream.
+/// @throws std::runtime_error If the file cannot be opened or ends before the range does; with MPI, on every process
+/// as soon as it happens on one of them.
+void ReadBinaryFileBytes(const std::string &path, std::size_t offset, std::span<std::byte> buffer);
+
+/// @brief Consecutive rows of a binary data file.
+/// @tparam T Element type.
+template <typename T>
+struct BinaryRows {
+  /// @brief Header of the whole file.
+  BinaryFileHeader header;
+  /// @brief Rows held in data.
+  BlockRange rows;
+  /// @brief rows.Size() * header.RowSize() elements in row-major order.
+  std::vector<T> data;
+};
+
+/// @brief Reads the rows in @p range of a binary data file.
+/// @details Collective like ReadBinaryFileBytes(); the range is clipped to the rows of the file.
+/// @tparam T Element type.
+template <typename T>
+BinaryRows<T> ReadBinaryRows(const std::string &path, const BinaryFileHeader &header, BlockRange range) {
+  static_assert(std::is_trivially_copyable_v<T>, "Binary data files hold trivially copyable elements");
+  range.end = std::min(range.end, header.dims.front());
+  range.begin = std::min(range.begin, range.end);
+  const std::size_t row_size = header.RowSize();
+  BinaryRows<T> rows{.header = header, .rows = range, .data = std::vector<T>(range.Size() * row_size)};
+  ReadBinaryFileBytes(path, header.data_offset + (range.begin * row_size * sizeof(T)),
+                      std::as_writable_bytes(std::span(rows.data)));
+  return rows;
+}
+
+/// @brief Reads a whole binary data file.
+/// @details Collective like ReadBinaryFileBytes().
+/// @tparam T Element type.
+template <typename T>
+BinaryRows<T> ReadBinaryFile(const std::string &path, BinaryHeaderType type, std::size_t num_dims) {
+  const auto header = ReadBinaryFileHeaderCollective(path, type, num_dims);
+  return ReadBinaryRows<T>(path, header, {.begin = 0, .end = header.dims.front()});
+}
+
+/// @brief Reads the rows of one process in a block partition of a binary data file, see GetBlockRange().
+/// @details Collective like ReadBinaryFileBytes(); no process reads the rows of another one.
+/// @tparam T Element type.
+template <typename T>
+BinaryRows<T> ReadBinaryRowBlock(const std::string &path, BinaryHeaderType type, std::size_t num_dims, int rank,
+                                 int num_ranks) {
+  const auto header = ReadBinaryFileHeaderCollective(path, type, num_dims);
+  return ReadBinaryRows<T>(path, header, GetBlockRange(header.dims.front(), rank, num_ranks));
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "util/include/matrix.hpp"
+#include "util/include/mpi_types.hpp"
+#include "util/include/partition.hpp"
+
+namespace ppc::util {
+
+/// @brief Default chunk size of PipelinedScatterv(); a chunk and the one in flight fit into a typical L2 cache.
+inline constexpr std::size_t kPipelineChunkBytes = std::size_t{256} << 10;
+
+/// @brief Limits of single MPI calls in the collectives below; the defaults are those of MPI itself.
+/// @details Smaller limits take the fallbacks for large transfers with small buffers, which is what tests use them for.
+/// They have to be the same on all processes.
+struct TransferLimits {
+  /// @brief Largest count or offset of one call, in units of its datatype.
+  std::size_t max_count = std::numeric_limits<int>::max();
+  /// @brief Unit of transfers that exceed max_count even in whole elements; with 1 MiB a message can carry 2 PiB.
+  std::size_t piece_bytes = std::size_t{1} << 20;
+};
+
+/// @brief MPI_Scatterv of elements of @p elem_size bytes; counts and offsets of @p partition are in elements.
+/// @details Collective over @p comm, and @p partition has to be the same on all processes. Counts and offsets are sent
+/// in bytes where they fit into limits.max_count, else in whole elements, and else the blocks go point to point in
+/// pieces of limits.piece_bytes.
+/// @param send partition.Total() elements on @p root; ignored on the other processes.
+/// @param recv At least partition.counts[rank] elements.
+/// @throws std::invalid_argument If a buffer of this process is too small for its part of @p partition. The other
+/// processes are left in the transfer; with IsCollectiveCheckEnabled(), i.e. PPC_CHECK_COLLECTIVES=1, all of them
+/// first agree on the checks and throw together, at the cost of one more synchronizing collective per call.
+void ScattervBytes(std::span<const std::byte> send, const BlockPartition &partition, std::span<std::byte> recv,
+                   std::size_t elem_size, int root, MPI_Comm comm, const TransferLimits &limits = {});
+
+/// @brief MPI_Gatherv counterpart of ScattervBytes(); @p recv is only used on @p root.
+void GathervBytes(std::span<const std::byte> send, const BlockPartition &partition, std::span<std::byte> recv,
+                  std::size_t elem_size, int root, MPI_Comm comm, const TransferLimits &limits = {});
+
+/// @brief MPI_Allgatherv counterpart of ScattervBytes(); @p recv receives partition.Total() elements everywhere.
+void AllgathervBytes(std::span<const std::byte> send, const BlockPartition &partition, std::span<std::byte> recv,
+                     std::size_t elem_size, MPI_Comm comm, const TransferLimits &limits = {});
+
+/// @brief MPI_Bcast of @p data from @p root; sizes beyond limits.max_count bytes are sent in several pieces.
+/// @details Collective over @p comm, and @p data has to be equally long on all processes.
+void BcastBytes(std::span<std::byte> data, int root, MPI_Comm comm, const TransferLimits &limits = {});
+
+/// @brief ScattervBytes() in rounds of at most @p chunk_elems elements per process, handing every received chunk to
+/// @p consume while the next one is in flight.
+/// @details Collective over @p comm, and @p partition and @p chunk_elems have to be the same on all processes. Round k
+/// is one MPI_Iscatterv of chunk k of every block into one of two buffers, which is posted before chunk k - 1 is
+/// consumed, so the distribution overlaps with the computation on the previous chunk. Counts and offsets are in bytes
+/// where they fit into limits.max_count, else in whole elements.
+/// @throws std::invalid_argument If @p send is too small on @p root, which throws on the other processes only as
+/// described for ScattervBytes(), or on every process if a block offset exceeds limits.max_count elements.
+void PipelinedScattervBytes(std::span<const std::byte> send, const BlockPartition &partition, std::size_t elem_size,
+                            std::size_t chunk_elems, const std::function<void(std::span<const std::byte>)> &consume,
+                            int root, MPI_Comm comm, const TransferLimits &limits = {});
+
+/// @brief Sends block r of the columns of a @p rows x @p cols matrix on @p root to process r.
+/// @details Collective over @p comm; @p rows, @p cols and @p columns have to be the same on all processes. Every
+/// process receives its columns one after another, i.e. in column-major order. A row-major matrix is sent straight
+/// from its buffer through a strided column datatype, see MakeColumnType(), so the root does not transpose it.
+/// @param send Elements of the matrix in @p layout order on @p root; ignored on the other processes.
+/// @param columns Block partition of the columns, e.g. GetBlockPartition(cols, size).
+/// @param recv At least columns.counts[rank] * rows elements.
+/// @param type MPI datatype of one element.
+/// @throws std::invalid_argument If a buffer of this process is too small, see ScattervBytes(), or on every process
+/// if a dimension exceeds INT_MAX.
+void ScatterColumnBlocks(std::span<const std::byte> send, MatrixLayout layout, std::size_t rows, std::size_t cols,
+                         const BlockPartition &columns, std::span<std::byte> recv, MPI_Datatype type, int root,
+                         MPI_Comm comm);
+
+/// @brief Sends block r of @p partition from @p send on @p root to process r, see ScattervBytes().
+/// @tparam T Trivially copyable element type.
+template <typename T>
+void Scatterv(std::span<const T> send, const BlockPartition &partition, std::span<T> recv, int root = 0,
+              MPI_Comm comm = MPI_COMM_WORLD) {
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be sent as bytes");
+  ScattervBytes(std::as_bytes(send), partition, std::as_writable_bytes(recv), sizeof(T), root, comm);
+}
+
+/// @brief Collects block r of @p partition from process r into @p recv on @p root, see GathervBytes().
+template <typename T>
+void Gatherv(std::span<const T> send, const BlockPartition &partition, std::span<T> recv, int root = 0,
+             MPI_Comm comm = MPI_COMM_WORLD) {
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be sent as bytes");
+  GathervBytes(std::as_bytes(send), partition, std::as_writable_bytes(recv), sizeof(T), root, comm);
+}
+
+/// @brief Collects block r of @p partition from process r into @p recv on every process, see AllgathervBytes().
+template <typename T>
+void Allgatherv(std::span<const T> send, const BlockPartition &partition, std::span<T> recv,
+                MPI_Comm comm = MPI_COMM_WORLD) {
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be sent as bytes");
+  AllgathervBytes(std::as_bytes(send), partition, std::as_writable_bytes(recv), sizeof(T), comm);
+}
+
+/// @brief Streams block r of @p partition from @p send on @p root to process r and calls @p kernel on each chunk of it,
+/// see PipelinedScattervBytes().
+/// @tparam Kernel Callable with a std::span<const T> argument.
+template <typename T, typename Kernel>
+void PipelinedScatterv(std::span<const T> send, const BlockPartition &partition, Kernel kernel, int root = 0,
+                       MPI_Comm comm = MPI_COMM_WORLD, std::size_t chunk_elems = kPipelineChunkBytes / sizeof(T)) {
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be sent as bytes");
+  PipelinedScattervBytes(
+      std::as_bytes(send), partition, sizeof(T), chunk_elems,
+      [&](std::span<const std::byte> chunk) {
+        kernel(std::span<const T>(reinterpret_cast<const T *>(chunk.data()), chunk.size() / sizeof(T)));
+      },
+      root, comm);
+}
+
+/// @brief Folds the chunks of every block with @p kernel and combines the results of all processes with @p op.
+/// @details The distribution overlaps with the folding, see PipelinedScatterv(), and a single MPI_Allreduce ends it.
+/// @param init Identity of @p op, e.g. the lowest value for MPI_MAX; it is also the result of empty blocks.
+/// @param kernel Callable as Acc(Acc, std::span<const T>) that folds one chunk into the partial result.
+/// @return Reduction over all elements on every process.
+template <typename T, typename Acc, typename Kernel>
+Acc PipelinedReduce(std::span<const T> send, const BlockPartition &partition, Acc init, Kernel kernel, MPI_Op op,
+                    int root = 0, MPI_Comm comm = MPI_COMM_WORLD,
+                    std::size_t chunk_elems = kPipelineChunkBytes / sizeof(T)) {
+  Acc local = init;
+  PipelinedScatterv<T>(
+      send, partition, [&](std::span<const T> chunk) { local = kernel(local, chunk); }, root, comm, chunk_elems);
+  Acc result = init;
+  MPI_Allreduce(&local, &result, 1, GetMpiType<Acc>(), op, comm);
+  return result;
+}
+
+/// @brief Sends blocks of whole columns of a matrix to the processes, see ScatterColumnBlocks().
+/// @tparam T Element type with an MPI datatype, see GetMpiType().
+template <typename T>
+void ScatterColumns(std::span<const T> send, MatrixLayout layout, std::size_t rows, std::size_t cols,
+                    const BlockPartition &columns, std::span<T> recv, int root = 0, MPI_Comm comm = MPI_COMM_WORLD) {
+  ScatterColumnBlocks(std::as_bytes(send), layout, rows, cols, columns, std::as_writable_bytes(recv),
+                      GetMpiType<T>(), root, comm);
+}
+
+}  // namespace ppc::util
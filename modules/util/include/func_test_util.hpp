@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -19,7 +20,8 @@
 namespace ppc::util {
 
 template <typename InType, typename OutType, typename TestType = void>
-using FuncTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string, TestType>;
+using FuncTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string, TestType,
+                                 ppc::task::InputResidency>;
 
 template <typename InType, typename OutType, typename TestType = void>
 using GTestFuncParam = ::testing::TestParamInfo<FuncTestParam<InType, OutType, TestType>>;
@@ -38,9 +40,19 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
  public:
   virtual bool CheckTestOutputData(OutType &output_data) = 0;
   /// @brief Provides input data for the task.
+  /// @details Ranks other than 0 of a root-only task do not call it, so a large input is built here rather than in
+  /// SetUp().
   /// @return Initialized input data.
   virtual InType GetTestInputData() = 0;
 
+  /// @brief Provides the part of the input held by one process of a task with InputResidency::kDistributed.
+  /// @param rank Rank of the process.
+  /// @param num_ranks Number of processes.
+  /// @return Input data of @p rank.
+  virtual InType GetTestInputDataOfRank(int /*rank*/, int /*num_ranks*/) {
+    throw std::runtime_error("A task with distributed input requires GetTestInputDataOfRank().");
+  }
+
   template <typename Derived>
   static void RequireStaticInterface() {
     static_assert(HasPrintTestParam<Derived, TestType>,
@@ -92,8 +104,13 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
   }
 
   /// @brief Initializes task instance and runs it through the full pipeline.
+  /// @details The input is generated according to the input residency of the task, see ppc::task::GetRankInputData().
   void InitializeAndRunTask(const FuncTestParam<InType, OutType, TestType> &test_param) {
-    task_ = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(test_param)(GetTestInputData());
+    const auto residency = std::get<static_cast<std::size_t>(GTestParamIndex::kInputResidency)>(test_param);
+    auto input = ppc::task::GetRankInputData<InType>(
+        residency, [this] { return GetTestInputData(); },
+        [this](int rank, int num_ranks) { return GetTestInputDataOfRank(rank, num_ranks); });
+    task_ = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(test_param)(std::move(input));
     ExecuteTaskPipeline();
   }
 
@@ -128,7 +145,7 @@ auto GenTaskTuplesImpl(const SizesContainer &sizes, const std::string &settings_
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<Task, InType>,
                                          std::string(GetNamespace<Task>()) + "_" +
                                              ppc::task::GetStringTaskType(Task::GetStaticTypeOfTask(), settings_path),
-                                         sizes[Is])...);
+                                         sizes[Is], Task::GetStaticInputResidency())...);
 }
 
 template <typename Task, typename InType, typename SizesContainer>
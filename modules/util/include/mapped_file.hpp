@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/include/binary_file.hpp"
+
+namespace ppc::util {
+
+/// @brief Expected access pattern of a mapped file, passed to the kernel as madvise() hint.
+enum class MapAdvice : uint8_t {
+  /// No particular pattern
+  kNormal,
+  /// Front-to-back scan; the kernel reads ahead aggressively and drops pages behind
+  kSequential,
+  /// Scattered accesses; read-ahead is disabled
+  kRandom,
+  /// The whole file is needed soon; the kernel starts reading it in the background
+  kWillNeed,
+  /// Back the mapping with transparent huge pages where the file system supports it
+  kHugePages
+};
+
+/// @brief Read-only memory mapping of a whole file.
+/// @details Pages are loaded on first access and shared through the page cache, so processes of one node that map the
+/// same file hold it in memory once, and a sequential scan can cover files larger than RAM. On platforms without
+/// mmap() the file is read into memory instead.
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  /// @brief Maps the file at @p path.
+  /// @throws std::runtime_error If the file cannot be opened or mapped.
+  explicit MappedFile(const std::string &path, MapAdvice advice = MapAdvice::kSequential);
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  ~MappedFile();
+
+  /// @brief Contents of the file.
+  [[nodiscard]] std::span<const std::byte> Bytes() const {
+    return {data_, size_};
+  }
+
+  /// @brief Contents of the file as text.
+  [[nodiscard]] std::string_view Text() const {
+    return {reinterpret_cast<const char *>(data_), size_};
+  }
+
+  /// @brief Size of the file in bytes.
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+
+  /// @brief Changes the access pattern hint; does nothing where hints are not supported.
+  void Advise(MapAdvice advice) const;
+
+ private:
+  void Release();
+
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  bool is_mapped_ = false;
+  // Holds the contents on platforms without mmap()
+  std::vector<std::byte> buffer_;
+};
+
+/// @brief Array of trivially copyable elements stored in a file, viewed through a MappedFile.
+/// @tparam T Element type.
+template <typename T>
+class MappedArray {
+  static_assert(std::is_trivially_copyable_v<T>, "Mapped arrays hold trivially copyable elements");
+
+ public:
+  /// @brief Maps all elements that follow the first @p offset bytes of the file.
+  /// @throws std::runtime_error If the file cannot be mapped or @p offset is beyond its end or misaligned for T.
+  explicit MappedArray(const std::string &path, std::size_t offset = 0, MapAdvice advice = MapAdvice::kSequential)
+      : file_(path, advice) {
+    View(offset, std::numeric_limits<std::size_t>::max());
+  }
+
+  /// @brief Maps the elements of a binary data file described by its header, see ReadBinaryFileHeader().
+  /// @throws std::runtime_error If the file cannot be mapped or is shorter than the header states.
+  MappedArray(const std::string &path, const BinaryFileHeader &header, MapAdvice advice = MapAdvice::kSequential)
+      : file_(path, advice) {
+    View(header.data_offset, header.dims.front() * header.RowSize());
+  }
+
+  /// @brief Mapped elements.
+  [[nodiscard]] std::span<const T> Data() const {
+    return data_;
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    return data_.size();
+  }
+
+  const T &operator[](std::size_t i) const {
+    return data_[i];
+  }
+
+  [[nodiscard]] auto begin() const {
+    return data_.begin();
+  }
+
+  [[nodiscard]] auto end() const {
+    return data_.end();
+  }
+
+  /// @brief Underlying file.
+  [[nodiscard]] const MappedFile &File() const {
+    return file_;
+  }
+
+ private:
+  // Views at most count elements starting at offset; the whole file if count is the maximum
+  void View(std::size_t offset, std::size_t count) {
+    if (offset > file_.Size() || offset % alignof(T) != 0) {
+      throw std::runtime_error("Invalid offset of mapped array elements");
+    }
+    const auto bytes = file_.Bytes().subspan(offset);
+    const std::size_t available = bytes.size() / sizeof(T);
+    if (count != std::numeric_limits<std::size_t>::max() && count > available) {
+      throw std::runtime_error("Mapped file is shorter than its header states");
+    }
+    data_ = std::span<const T>(reinterpret_cast<const T *>(bytes.data()), std::min(count, available));
+  }
+
+  MappedFile file_;
+  std::span<const T> data_;
+};
+
+/// @brief Input of a test stored in a binary data file, mapped on first access.
+/// @details The header is read on construction on every process, so that a missing or broken file fails the test on
+/// all of them instead of leaving the others waiting in a collective. The elements are mapped only when first needed:
+/// processes that receive their part of the input from the root map the file just for the check after the run, and
+/// the processes of a node share one copy of it in the page cache.
+/// @tparam T Element type.
+template <typename T>
+class LazyMappedInput {
+ public:
+  LazyMappedInput() = default;
+
+  /// @brief Reads the header of the file at @p path, see ReadBinaryFileHeader().
+  /// @throws std::runtime_error If the header cannot be read.
+  LazyMappedInput(std::string path, BinaryHeaderType type, std::size_t num_dims)
+      : header_(ReadBinaryFileHeader(path, type, num_dims)), path_(std::move(path)) {}
+
+  [[nodiscard]] const BinaryFileHeader &Header() const {
+    return header_;
+  }
+
+  /// @brief Elements of the file, mapped on the first call.
+  /// @throws std::runtime_error If the file cannot be mapped or is shorter than its header states.
+  const MappedArray<T> &Array() {
+    if (!array_) {
+      array_.emplace(path_, header_);
+    }
+    return *array_;
+  }
+
+ private:
+  BinaryFileHeader header_;
+  std::string path_;
+  std::optional<MappedArray<T>> array_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Allocator returning memory aligned to @p Alignment bytes, e.g. to a cache line or a vector register.
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+  static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {  // NOLINT(readability-identifier-naming)
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> & /*other*/) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  T *allocate(std::size_t n) {  // NOLINT(readability-identifier-naming)
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T *ptr, std::size_t /*n*/) noexcept {  // NOLINT(readability-identifier-naming)
+    ::operator delete(ptr, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> & /*other*/) const noexcept {
+    return true;
+  }
+};
+
+/// @brief Storage order of matrix elements.
+enum class MatrixLayout : uint8_t {
+  /// Rows are contiguous
+  kRowMajor,
+  /// Columns are contiguous, so a block of columns can be sent as one buffer
+  kColMajor
+};
+
+/// @brief Non-owning view of @p size elements that are @p stride elements apart, e.g. a column of a row-major matrix.
+/// @tparam T Element type, const for read-only views.
+template <typename T>
+class StridedSpan {
+ public:
+  /// @brief Forward iterator over the viewed elements.
+  class Iterator {
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+
+    Iterator() = default;
+    Iterator(T *ptr, std::size_t stride) : ptr_(ptr), stride_(stride) {}
+
+    T &operator*() const {
+      return *ptr_;
+    }
+
+    Iterator &operator++() {
+      ptr_ += stride_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return ptr_ == other.ptr_;
+    }
+
+   private:
+    T *ptr_ = nullptr;
+    std::size_t stride_ = 1;
+  };
+
+  StridedSpan(T *data, std::size_t size, std::size_t stride) : data_(data), size_(size), stride_(stride) {}
+
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+
+  /// @brief Distance between consecutive elements in elements; 1 for contiguous views.
+  [[nodiscard]] std::size_t Stride() const {
+    return stride_;
+  }
+
+  T &operator[](std::size_t i) const {
+    return data_[i * stride_];
+  }
+
+  [[nodiscard]] Iterator begin() const {
+    return {data_, stride_};
+  }
+
+  [[nodiscard]] Iterator end() const {
+    return {data_ + (size_ * stride_), stride_};
+  }
+
+ private:
+  T *data_;
+  std::size_t size_;
+  std::size_t stride_;
+};
+
+/// @brief Non-owning view of a matrix or of a rectangular block of it.
+/// @tparam T Element type, const for read-only views.
+template <typename T>
+class MatrixView {
+ public:
+  /// @brief Views @p rows x @p cols elements; element (i, j) is data[i * row_stride + j * col_stride].
+  MatrixView(T *data, std::size_t rows, std::size_t cols, std::size_t row_stride, std::size_t col_stride)
+      : data_(data), rows_(rows), cols_(cols), row_stride_(row_stride), col_stride_(col_stride) {}
+
+  // NOLINTNEXTLINE(google-explicit-constructor): a mutable view is usable wherever a read-only one is expected
+  operator MatrixView<const T>() const {
+    return {data_, rows_, cols_, row_stride_, col_stride_};
+  }
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+
+  [[nodiscard]] bool Empty() const {
+    return rows_ == 0 || cols_ == 0;
+  }
+
+  T &operator()(std::size_t row, std::size_t col) const {
+    return data_[(row * row_stride_) + (col * col_stride_)];
+  }
+
+  [[nodiscard]] StridedSpan<T> Row(std::size_t row) const {
+    return {data_ + (row * row_stride_), cols_, col_stride_};
+  }
+
+  [[nodiscard]] StridedSpan<T> Col(std::size_t col) const {
+    return {data_ + (col * col_stride_), rows_, row_stride_};
+  }
+
+  /// @brief Views the @p rows x @p cols block whose top left element is (@p row, @p col); nothing is copied.
+  /// @throws std::out_of_range If the block does not fit into this view.
+  [[nodiscard]] MatrixView Block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+    if (row > rows_ || col > cols_ || rows > rows_ - row || cols > cols_ - col) {
+      throw std::out_of_range("Matrix block is out of range");
+    }
+    return {data_ + (row * row_stride_) + (col * col_stride_), rows, cols, row_stride_, col_stride_};
+  }
+
+ private:
+  T *data_;
+  std::size_t rows_;
+  std::size_t cols_;
+  std::size_t row_stride_;
+  std::size_t col_stride_;
+};
+
+/// @brief Dense matrix stored in one aligned contiguous buffer.
+/// @details Unlike a vector of rows, the elements need a single allocation, can be handed to MPI without repacking
+/// and are laid out for vectorised loops. The layout decides which of rows and columns are contiguous.
+/// @tparam T Element type.
+template <typename T>
+class Matrix {
+ public:
+  using Storage = std::vector<T, AlignedAllocator<T>>;
+
+  Matrix() = default;
+
+  /// @brief Creates a @p rows x @p cols matrix filled with @p value.
+  Matrix(std::size_t rows, std::size_t cols, MatrixLayout layout = MatrixLayout::kRowMajor, const T &value = T{})
+      : rows_(rows), cols_(cols), layout_(layout), data_(rows * cols, value) {}
+
+  /// @brief Creates a @p rows x @p cols matrix from elements stored in @p layout order.
+  /// @throws std::invalid_argument If @p values does not hold rows * cols elements.
+  Matrix(std::size_t rows, std::size_t cols, std::span<const T> values, MatrixLayout layout = MatrixLayout::kRowMajor)
+      : rows_(rows), cols_(cols), layout_(layout), data_(values.begin(), values.end()) {
+    if (data_.size() != rows * cols) {
+      throw std::invalid_argument("Number of matrix elements does not match its dimensions");
+    }
+  }
+
+  /// @brief Copies a vector of rows into a matrix with the given layout.
+  /// @throws std::invalid_argument If the rows differ in length.
+  static Matrix FromRows(const std::vector<std::vector<T>> &rows, MatrixLayout layout = MatrixLayout::kRowMajor) {
+    Matrix matrix(rows.size(), rows.empty() ? 0 : rows.front().size(), layout);
+    for (std::size_t i = 0; i < rows.size(); i++) {
+      if (rows[i].size() != matrix.cols_) {
+        throw std::invalid_argument("Matrix rows differ in length");
+      }
+      for (std::size_t j = 0; j < matrix.cols_; j++) {
+        matrix(i, j) = rows[i][j];
+      }
+    }
+    return matrix;
+  }
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+
+  [[nodiscard]] MatrixLayout Layout() const {
+    return layout_;
+  }
+
+  [[nodiscard]] bool Empty() const {
+    return data_.empty();
+  }
+
+  /// @brief All elements in layout order.
+  [[nodiscard]] std::span<T> Data() {
+    return data_;
+  }
+
+  [[nodiscard]] std::span<const T> Data() const {
+    return data_;
+  }
+
+  T &operator()(std::size_t row, std::size_t col) {
+    return data_[Index(row, col)];
+  }
+
+  const T &operator()(std::size_t row, std::size_t col) const {
+    return data_[Index(row, col)];
+  }
+
+  [[nodiscard]] MatrixView<T> View() {
+    return {data_.data(), rows_, cols_, RowStride(), ColStride()};
+  }
+
+  [[nodiscard]] MatrixView<const T> View() const {
+    return {data_.data(), rows_, cols_, RowStride(), ColStride()};
+  }
+
+  [[nodiscard]] StridedSpan<T> Row(std::size_t row) {
+    return View().Row(row);
+  }
+
+  [[nodiscard]] StridedSpan<const T> Row(std::size_t row) const {
+    return View().Row(row);
+  }
+
+  [[nodiscard]] StridedSpan<T> Col(std::size_t col) {
+    return View().Col(col);
+  }
+
+  [[nodiscard]] StridedSpan<const T> Col(std::size_t col) const {
+    return View().Col(col);
+  }
+
+  /// @copydoc MatrixView::Block
+  [[nodiscard]] MatrixView<T> Block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) {
+    return View().Block(row, col, rows, cols);
+  }
+
+  [[nodiscard]] MatrixView<const T> Block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+    return View().Block(row, col, rows, cols);
+  }
+
+  /// @brief Copy of the matrix stored in @p layout order.
+  [[nodiscard]] Matrix ToLayout(MatrixLayout layout) const {
+    if (layout == layout_) {
+      return *this;
+    }
+    Matrix result(rows_, cols_, layout);
+    for (std::size_t i = 0; i < rows_; i++) {
+      for (std::size_t j = 0; j < cols_; j++) {
+        result(i, j) = (*this)(i, j);
+      }
+    }
+    return result;
+  }
+
+  /// @brief Compares dimensions and elements; matrices with different layouts can be equal.
+  bool operator==(const Matrix &other) const {
+    if (rows_ != other.rows_ || cols_ != other.cols_) {
+      return false;
+    }
+    if (layout_ == other.layout_) {
+      return data_ == other.data_;
+    }
+    for (std::size_t i = 0; i < rows_; i++) {
+      for (std::size_t j = 0; j < cols_; j++) {
+        if ((*this)(i, j) != other(i, j)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+ private:
+  [[nodiscard]] std::size_t RowStride() const {
+    return layout_ == MatrixLayout::kRowMajor ? cols_ : 1;
+  }
+
+  [[nodiscard]] std::size_t ColStride() const {
+    return layout_ == MatrixLayout::kRowMajor ? 1 : rows_;
+  }
+
+  [[nodiscard]] std::size_t Index(std::size_t row, std::size_t col) const {
+    return (row * RowStride()) + (col * ColStride());
+  }
+
+  std::size_t rows_ = 0;
+  std::size_t cols_ = 0;
+  MatrixLayout layout_ = MatrixLayout::kRowMajor;
+  Storage data_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "util/include/matrix.hpp"
+#include "util/include/partition.hpp"
+
+namespace ppc::util {
+
+/// @brief Committed MPI datatype that is freed together with the object.
+class MpiDatatype {
+ public:
+  MpiDatatype() = default;
+
+  /// @brief Commits @p type and takes ownership of it.
+  explicit MpiDatatype(MPI_Datatype type);
+
+  MpiDatatype(const MpiDatatype &) = delete;
+  MpiDatatype &operator=(const MpiDatatype &) = delete;
+  MpiDatatype(MpiDatatype &&other) noexcept;
+  MpiDatatype &operator=(MpiDatatype &&other) noexcept;
+  ~MpiDatatype();
+
+  [[nodiscard]] MPI_Datatype Get() const {
+    return type_;
+  }
+
+ private:
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+};
+
+/// @brief @p count consecutive elements of @p base as one element.
+MpiDatatype MakeContiguousType(std::size_t count, MPI_Datatype base);
+
+/// @brief One column of a matrix whose rows are @p row_stride elements apart, e.g. of a row-major matrix.
+/// @details The extent is resized to one element of @p base, so count k starting at column j describes columns j to
+/// j + k - 1. This lets MPI_Scatterv hand out blocks of columns of a row-major matrix without packing them first.
+MpiDatatype MakeColumnType(std::size_t rows, std::size_t row_stride, MPI_Datatype base);
+
+/// @brief Block of a @p rows x @p cols matrix stored in @p layout order, see GetBlock2D().
+/// @throws std::invalid_argument If a dimension exceeds INT_MAX.
+MpiDatatype MakeSubarrayType(std::size_t rows, std::size_t cols, const Block2D &block, MatrixLayout layout,
+                             MPI_Datatype base);
+
+/// @brief Committed struct datatype of two members at the given byte displacements within an object of @p extent.
+/// @details Not freed: it is cached for the lifetime of the program, see GetMpiType().
+MPI_Datatype CreatePersistentPairType(MPI_Datatype first, MPI_Aint first_offset, MPI_Datatype second,
+                                      MPI_Aint second_offset, std::size_t extent);
+
+/// @brief Committed datatype of @p size opaque bytes, cached like CreatePersistentPairType().
+MPI_Datatype CreatePersistentBytesType(std::size_t size);
+
+/// @brief Whether T is a std::pair.
+template <typename T>
+struct IsPair : std::false_type {};
+
+template <typename First, typename Second>
+struct IsPair<std::pair<First, Second>> : std::true_type {};
+
+/// @brief Whether T maps to a predefined MPI datatype, which reduction operations like MPI_SUM require.
+template <typename T>
+inline constexpr bool kHasPredefinedMpiType =
+    std::is_arithmetic_v<std::remove_cv_t<T>> || std::is_same_v<std::remove_cv_t<T>, std::byte>;
+
+/// @brief MPI datatype of T, chosen at compile time.
+/// @details Arithmetic types map to the matching predefined datatype. Pairs with an int second member map to the
+/// predefined pair types used by MPI_MINLOC and MPI_MAXLOC, other pairs to a struct of both members, and any other
+/// trivially copyable type to its bytes. Derived datatypes are created on first use and kept until the program ends,
+/// because they may still be needed after every local object is gone.
+/// @tparam T Element type.
+template <typename T>
+MPI_Datatype GetMpiType() {
+  using U = std::remove_cv_t<T>;
+  // std::pair is not trivially copyable because of its assignment operator; its members are checked one by one
+  static_assert(std::is_trivially_copyable_v<U> || IsPair<U>::value,
+                "Only trivially copyable types can be sent without packing");
+  if constexpr (std::is_same_v<U, bool>) {
+    return MPI_CXX_BOOL;
+  } else if constexpr (std::is_same_v<U, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_same_v<U, signed char>) {
+    return MPI_SIGNED_CHAR;
+  } else if constexpr (std::is_same_v<U, unsigned char>) {
+    return MPI_UNSIGNED_CHAR;
+  } else if constexpr (std::is_same_v<U, wchar_t>) {
+    return MPI_WCHAR;
+  } else if constexpr (std::is_same_v<U, short>) {
+    return MPI_SHORT;
+  } else if constexpr (std::is_same_v<U, unsigned short>) {
+    return MPI_UNSIGNED_SHORT;
+  } else if constexpr (std::is_same_v<U, int>) {
+    return MPI_INT;
+  } else if constexpr (std::is_same_v<U, unsigned>) {
+    return MPI_UNSIGNED;
+  } else if constexpr (std::is_same_v<U, long>) {
+    return MPI_LONG;
+  } else if constexpr (std::is_same_v<U, unsigned long>) {
+    return MPI_UNSIGNED_LONG;
+  } else if constexpr (std::is_same_v<U, long long>) {
+    return MPI_LONG_LONG;
+  } else if constexpr (std::is_same_v<U, unsigned long long>) {
+    return MPI_UNSIGNED_LONG_LONG;
+  } else if constexpr (std::is_same_v<U, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<U, double>) {
+    return MPI_DOUBLE;
+  } else if constexpr (std::is_same_v<U, long double>) {
+    return MPI_LONG_DOUBLE;
+  } else if constexpr (std::is_same_v<U, std::byte>) {
+    return MPI_BYTE;
+  } else if constexpr (std::is_same_v<U, std::pair<int, int>>) {
+    return MPI_2INT;
+  } else if constexpr (std::is_same_v<U, std::pair<short, int>>) {
+    return MPI_SHORT_INT;
+  } else if constexpr (std::is_same_v<U, std::pair<long, int>>) {
+    return MPI_LONG_INT;
+  } else if constexpr (std::is_same_v<U, std::pair<float, int>>) {
+    return MPI_FLOAT_INT;
+  } else if constexpr (std::is_same_v<U, std::pair<double, int>>) {
+    return MPI_DOUBLE_INT;
+  } else if constexpr (std::is_same_v<U, std::pair<long double, int>>) {
+    return MPI_LONG_DOUBLE_INT;
+  } else if constexpr (IsPair<U>::value) {
+    static const MPI_Datatype kType = [] {
+      const U sample{};
+      MPI_Aint base = 0;
+      MPI_Aint first = 0;
+      MPI_Aint second = 0;
+      MPI_Get_address(&sample, &base);
+      MPI_Get_address(&sample.first, &first);
+      MPI_Get_address(&sample.second, &second);
+      return CreatePersistentPairType(GetMpiType<typename U::first_type>(), MPI_Aint_diff(first, base),
+                                      GetMpiType<typename U::second_type>(), MPI_Aint_diff(second, base), sizeof(U));
+    }();
+    return kType;
+  } else {
+    static const MPI_Datatype kType = CreatePersistentBytesType(sizeof(U));
+    return kType;
+  }
+}
+
+/// @brief MakeColumnType() for elements of type T.
+template <typename T>
+MpiDatatype MakeColumnType(std::size_t rows, std::size_t row_stride) {
+  return MakeColumnType(rows, row_stride, GetMpiType<T>());
+}
+
+/// @brief MakeSubarrayType() for elements of type T.
+template <typename T>
+MpiDatatype MakeSubarrayType(std::size_t rows, std::size_t cols, const Block2D &block,
+                             MatrixLayout layout = MatrixLayout::kRowMajor) {
+  return MakeSubarrayType(rows, cols, block, layout, GetMpiType<T>());
+}
+
+}  // namespace ppc::util
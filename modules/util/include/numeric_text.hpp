@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Numbers of a text file, one row per non-empty line, stored in a flat row-major array.
+/// @tparam T Number type.
+template <typename T>
+struct NumericTable {
+  /// @brief All numbers in file order.
+  std::vector<T> values;
+  /// @brief Start of every row in values, followed by values.size().
+  std::vector<std::size_t> row_offsets = {0};
+
+  /// @brief Number of rows.
+  [[nodiscard]] std::size_t Rows() const {
+    return row_offsets.size() - 1;
+  }
+
+  /// @brief Numbers of one row.
+  [[nodiscard]] std::span<const T> Row(std::size_t row) const {
+    return std::span<const T>(values).subspan(row_offsets[row], row_offsets[row + 1] - row_offsets[row]);
+  }
+
+  /// @brief Number of columns if all rows have the same length, otherwise 0.
+  [[nodiscard]] std::size_t Cols() const {
+    const std::size_t cols = Rows() > 0 ? row_offsets[1] : 0;
+    for (std::size_t row = 1; row < Rows(); row++) {
+      if (row_offsets[row + 1] - row_offsets[row] != cols) {
+        return 0;
+      }
+    }
+    return cols;
+  }
+};
+
+/// @brief Parses whitespace- or comma-separated numbers with std::from_chars.
+/// @details The text is split at line boundaries into one chunk per thread; the chunks are parsed with OpenMP and then
+/// concatenated. Empty lines are skipped.
+/// @tparam T int, int64_t, float or double.
+/// @param text Text to parse.
+/// @param num_threads Number of threads; 0 uses GetNumThreads(). Small texts are parsed by fewer threads.
+/// @throws std::runtime_error If the text contains something other than numbers and separators, or a number is not
+/// followed by a separator or line break.
+template <typename T>
+NumericTable<T> ParseNumericText(std::string_view text, int num_threads = 0);
+
+/// @brief Maps a text file with MappedFile and parses it with ParseNumericText().
+/// @throws std::runtime_error If the file cannot be mapped or parsed.
+template <typename T>
+NumericTable<T> ParseNumericFile(const std::string &path, int num_threads = 0);
+
+}  // namespace ppc::util
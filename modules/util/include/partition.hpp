@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Half-open range [begin, end) of items owned by one process.
+struct BlockRange {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+
+  /// @brief Number of items in the range.
+  [[nodiscard]] std::size_t Size() const {
+    return end - begin;
+  }
+};
+
+/// @brief Returns the items of one process in a block partition of @p count items over @p num_ranks processes.
+/// @details The first count % num_ranks processes get one item more than the others, so block sizes differ by at
+/// most one and the blocks follow each other in rank order.
+inline BlockRange GetBlockRange(std::size_t count, int rank, int num_ranks) {
+  const auto ranks = static_cast<std::size_t>(std::max(num_ranks, 1));
+  const auto r = static_cast<std::size_t>(rank);
+  const std::size_t base = count / ranks;
+  const std::size_t rest = count % ranks;
+  const std::size_t begin = (r * base) + std::min(r, rest);
+  return {.begin = begin, .end = begin + base + (r < rest ? 1 : 0)};
+}
+
+/// @brief Block partition of items over all processes, as passed to MPI_Scatterv and MPI_Gatherv.
+struct BlockPartition {
+  /// @brief Number of items of every process.
+  std::vector<std::size_t> counts;
+  /// @brief Offset of the first item of every process.
+  std::vector<std::size_t> displs;
+
+  /// @brief Number of items of all processes together.
+  [[nodiscard]] std::size_t Total() const {
+    return counts.empty() ? 0 : displs.back() + counts.back();
+  }
+
+  /// @brief Items of one process.
+  [[nodiscard]] BlockRange Range(int rank) const {
+    const auto r = static_cast<std::size_t>(rank);
+    return {.begin = displs[r], .end = displs[r] + counts[r]};
+  }
+};
+
+/// @brief Block partition of @p count units over @p num_ranks processes, see GetBlockRange().
+/// @param unit Items per unit, e.g. the row length when whole rows are distributed. Counts and offsets are in items.
+inline BlockPartition GetBlockPartition(std::size_t count, int num_ranks, std::size_t unit = 1) {
+  const int ranks = std::max(num_ranks, 1);
+  BlockPartition partition{.counts = std::vector<std::size_t>(ranks), .displs = std::vector<std::size_t>(ranks)};
+  for (int r = 0; r < ranks; r++) {
+    const BlockRange range = GetBlockRange(count, r, ranks);
+    partition.counts[r] = range.Size() * unit;
+    partition.displs[r] = range.begin * unit;
+  }
+  return partition;
+}
+
+/// @brief Processes arranged in a grid, numbered row by row like in MPI_Cart_create.
+struct ProcessGrid {
+  int rows = 1;
+  int cols = 1;
+};
+
+/// @brief Most square grid of @p num_ranks processes; it has at least as many rows as columns.
+inline ProcessGrid GetProcessGrid(int num_ranks) {
+  const int ranks = std::max(num_ranks, 1);
+  int cols = 1;
+  for (int c = 1; c * c <= ranks; c++) {
+    if (ranks % c == 0) {
+      cols = c;
+    }
+  }
+  return {.rows = ranks / cols, .cols = cols};
+}
+
+/// @brief Rows and columns of a matrix owned by one process.
+struct Block2D {
+  BlockRange rows;
+  BlockRange cols;
+};
+
+/// @brief Returns the block of one process in a 2-D block partition of a @p rows x @p cols matrix over @p grid.
+/// @details Rows are split over the grid rows and columns over the grid columns, both like in GetBlockRange().
+inline Block2D GetBlock2D(std::size_t rows, std::size_t cols, int rank, ProcessGrid grid) {
+  return {.rows = GetBlockRange(rows, rank / grid.cols, grid.rows),
+          .cols = GetBlockRange(cols, rank % grid.cols, grid.cols)};
+}
+
+}  // namespace ppc::util
@@ -6,26 +6,41 @@
 #include <chrono>
 #include <csignal>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iostream>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "oneapi/tbb/global_control.h"
+#include "performance/include/calibration.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/results_writer.hpp"
+#include "performance/include/scaling.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
 
 double GetTimeMPI();
-int GetMPIRank();
+/// @brief Makes every process adopt the decision taken on rank 0.
+bool BcastRootDecisionMPI(bool decision);
+
+/// @brief Scaling report shared by all performance test suites of the process.
+inline ppc::performance::ScalingReport &GetScalingReport() {
+  static ppc::performance::ScalingReport report;
+  return report;
+}
 
 template <typename InType, typename OutType>
 using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
-                                 ppc::performance::PerfResults::TypeOfRunning>;
+                                 ppc::performance::PerfResults::TypeOfRunning, ppc::task::InputResidency>;
 
 template <typename InType, typename OutType>
 /// @brief Base class for performance testing of parallel tasks.
@@ -33,6 +48,13 @@ template <typename InType, typename OutType>
 /// @tparam OutType Output data type.
 class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, OutType>> {
  public:
+  /// @brief Prints the sweep runs of the suite that are still waiting for a sequential reference.
+  static void TearDownTestSuite() {
+    for (const auto &line : GetScalingReport().TakePending()) {
+      std::cout << line << '\n';
+    }
+  }
+
   /// @brief Generates a readable name for the performance test case.
   static std::string CustomPerfTestName(const ::testing::TestParamInfo<PerfTestParam<InType, OutType>> &info) {
     return ppc::performance::GetStringParamName(
@@ -43,13 +65,37 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
  protected:
   virtual bool CheckTestOutputData(OutType &output_data) = 0;
   /// @brief Supplies input data for performance testing.
+  /// @details Ranks other than 0 of a root-only task do not call it, so a large input is built here rather than in
+  /// SetUp().
   virtual InType GetTestInputData() = 0;
 
+  /// @brief Supplies the part of the input held by one process of a task with InputResidency::kDistributed.
+  virtual InType GetTestInputDataOfRank(int /*rank*/, int /*num_ranks*/) {
+    throw std::runtime_error("A task with distributed input requires GetTestInputDataOfRank().");
+  }
+
+  /// @brief Input sizes of the size sweep run with PPC_PERF_SIZE_SWEEP; empty (the default) disables the sweep.
+  virtual std::vector<std::size_t> GetTestInputSizes() {
+    return {};
+  }
+
+  /// @brief Generates the input of the given size for the size sweep.
+  /// @details Called right before the task is created, so it may also update the expectations that
+  /// CheckTestOutputData() compares against. For a root-only task only rank 0 calls it.
+  virtual InType GetTestInputDataOfSize(std::size_t /*size*/) {
+    throw std::runtime_error("GetTestInputSizes() is overridden without GetTestInputDataOfSize().");
+  }
+
   virtual void SetPerfAttributes(ppc::performance::PerfAttr &perf_attrs) {
+    perf_attrs.num_warmup = static_cast<uint64_t>(GetPerfWarmupRuns());
+    perf_attrs.adaptive = IsPerfAdaptive();
+    perf_attrs.hw_counters = IsPerfHwCountersEnabled();
+    perf_attrs.peak_bandwidth_gbs = GetPerfPeakBandwidth();
     if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
         task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
       const double t0 = GetTimeMPI();
       perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
+      perf_attrs.sync_decision = BcastRootDecisionMPI;
     } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kOMP) {
       const double t0 = omp_get_wtime();
       perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
@@ -57,7 +103,7 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSTL ||
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kTBB) {
       const auto t0 = std::chrono::high_resolution_clock::now();
-      perf_attrs.current_timer = [&] {
+      perf_attrs.current_timer = [t0] {
         auto now = std::chrono::high_resolution_clock::now();
         auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
         return static_cast<double>(ns) * 1e-9;
@@ -71,6 +117,7 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     auto task_getter = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(perf_test_param);
     auto test_name = std::get<static_cast<std::size_t>(GTestParamIndex::kNameTest)>(perf_test_param);
     auto mode = std::get<static_cast<std::size_t>(GTestParamIndex::kTestParams)>(perf_test_param);
+    residency_ = std::get<static_cast<std::size_t>(GTestParamIndex::kInputResidency)>(perf_test_param);
 
     ASSERT_FALSE(test_name.find("unknown") != std::string::npos);
     if (test_name.find("disabled") != std::string::npos) {
@@ -79,10 +126,31 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
     const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
 
-    task_ = task_getter(GetTestInputData());
+    const auto mode_name = ppc::performance::GetStringParamName(mode);
+    max_num_threads_ = GetMaxNumThreads();
+    // Thread counts do not reach MPI-only implementations, so they run once as without a sweep
+    const auto type_name = GetTaskTypeName(test_name);
+    thread_sweep_ = type_name == "mpi" ? std::vector<int>{} : GetPerfThreadSweep();
+    is_sweep_reference_ = type_name == "seq";
+    const auto input_sizes = IsPerfSizeSweepEnabled() ? GetTestInputSizes() : std::vector<std::size_t>{};
+    if (input_sizes.empty()) {
+      RunThreadCounts(task_getter, GetRankInputData([this] { return GetTestInputData(); }), test_name,
+                      ppc::performance::GetScalingKey(test_name, mode_name), mode);
+    } else {
+      SweepSizes(task_getter, test_name, mode, input_sizes);
+    }
+  }
+
+ private:
+  using TaskGetter = std::function<ppc::task::TaskPtr<InType, OutType>(InType)>;
+
+  void RunPerfCase(const TaskGetter &task_getter, InType input, const std::string &test_name,
+                   ppc::performance::PerfResults::TypeOfRunning mode, ppc::performance::PerfResults &perf_results) {
+    task_ = task_getter(std::move(input));
     ppc::performance::Perf perf(task_);
     ppc::performance::PerfAttr perf_attr;
     SetPerfAttributes(perf_attr);
+    ApplyCalibration(perf_attr);
 
     if (mode == ppc::performance::PerfResults::TypeOfRunning::kPipeline) {
       perf.PipelineRun(perf_attr);
@@ -94,7 +162,15 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
       throw std::runtime_error(err_msg.str().c_str());
     }
 
+    if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
+        task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
+      perf.CollectRankImbalance();
+      perf.CollectMpiProfiles();
+    }
+
+    perf_results = perf.GetPerfResults();
     if (GetMPIRank() == 0) {
+      WriteResultsFile(test_name, perf_results);
       perf.PrintPerfStatistic(test_name);
     }
 
@@ -102,8 +178,160 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     ASSERT_TRUE(CheckTestOutputData(output_data));
   }
 
- private:
+  // Runs the case once, or once per count of PPC_PERF_THREAD_SWEEP; returns the median time per thread count.
+  // A single run hands the input over to the task; a sweep keeps it and gives every run its own copy.
+  std::map<int, double> RunThreadCounts(const TaskGetter &task_getter, InType input,
+                                        const std::string &test_name, const std::string &scaling_key,
+                                        ppc::performance::PerfResults::TypeOfRunning mode) {
+    if (thread_sweep_.empty()) {
+      ppc::performance::PerfResults perf_results;
+      RunPerfCase(task_getter, std::move(input), test_name, mode, perf_results);
+      return {{GetNumThreads(), perf_results.median_sec}};
+    }
+    return SweepThreads(task_getter, input, test_name, scaling_key, mode, thread_sweep_);
+  }
+
+  // Re-runs the case for every count of PPC_PERF_THREAD_SWEEP in this process and reports speedup over the
+  // sequential implementation, which runs once as the reference. Thread counts reach the task through
+  // GetNumThreads(), the OpenMP default and a TBB limit that are all replaced per run.
+  std::map<int, double> SweepThreads(const TaskGetter &task_getter, const InType &input, const std::string &test_name,
+                                     const std::string &scaling_key, ppc::performance::PerfResults::TypeOfRunning mode,
+                                     const std::vector<int> &thread_sweep) {
+    const bool is_reference = is_sweep_reference_;
+    const auto mode_name = ppc::performance::GetStringParamName(mode);
+    const int default_omp_threads = omp_get_max_threads();
+
+    std::map<int, double> times;
+    for (const int threads : is_reference ? std::vector<int>{1} : thread_sweep) {
+      const env::detail::set_scoped_environment_variable num_threads_env("PPC_NUM_THREADS", std::to_string(threads));
+      omp_set_num_threads(threads);
+      const tbb::global_control control(tbb::global_control::max_allowed_parallelism, threads);
+
+      const auto run_name = is_reference ? test_name : test_name + "_t" + std::to_string(threads);
+      ppc::performance::PerfResults perf_results;
+      RunPerfCase(task_getter, input, run_name, mode, perf_results);
+      if (::testing::Test::HasFatalFailure()) {
+        break;
+      }
+      times[threads] = perf_results.median_sec;
+      if (GetMPIRank() != 0) {
+        continue;
+      }
+      const auto lines = is_reference ? GetScalingReport().AddReference(scaling_key, perf_results.median_sec)
+                                      : GetScalingReport().AddPoint(scaling_key, {.label = run_name + ":" + mode_name,
+                                                                                  .threads = threads,
+                                                                                  .workers = GetTaskParallelism(),
+                                                                                  .time_sec = perf_results.median_sec});
+      for (const auto &line : lines) {
+        std::cout << line << '\n';
+      }
+    }
+    omp_set_num_threads(default_omp_threads);
+    return times;
+  }
+
+  // Runs the case for every size of GetTestInputSizes() and reports the time-versus-size curve with its fitted
+  // complexity, one curve per thread count of the thread sweep
+  void SweepSizes(const TaskGetter &task_getter, const std::string &test_name,
+                  ppc::performance::PerfResults::TypeOfRunning mode, const std::vector<std::size_t> &input_sizes) {
+    if (residency_ == ppc::task::InputResidency::kDistributed) {
+      throw std::runtime_error("The size sweep does not support tasks with distributed input.");
+    }
+    const auto mode_name = ppc::performance::GetStringParamName(mode);
+    std::map<int, std::vector<ppc::performance::SizePoint>> curves;
+    for (const std::size_t size : input_sizes) {
+      const auto size_suffix = "_n" + std::to_string(size);
+      const auto times =
+          RunThreadCounts(task_getter, GetRankInputData([this, size] { return GetTestInputDataOfSize(size); }),
+                          test_name + size_suffix,
+                          ppc::performance::GetScalingKey(test_name, mode_name) + size_suffix, mode);
+      if (::testing::Test::HasFatalFailure()) {
+        return;
+      }
+      for (const auto &[threads, time_sec] : times) {
+        curves[threads].push_back({.size = size, .time_sec = time_sec});
+      }
+    }
+
+    if (GetMPIRank() != 0) {
+      return;
+    }
+    const bool is_thread_swept = !thread_sweep_.empty() && !is_sweep_reference_;
+    for (const auto &[threads, curve] : curves) {
+      const auto label = (is_thread_swept ? test_name + "_t" + std::to_string(threads) : test_name) + ":" + mode_name;
+      for (const auto &line : ppc::performance::FormatSizeCurve(label, curve)) {
+        std::cout << line << '\n';
+      }
+    }
+  }
+
+  // Implementation type of a test named "<task>_<type>_<status>", see ppc::task::GetStringTaskType()
+  static std::string GetTaskTypeName(const std::string &test_name) {
+    const auto status_begin = test_name.rfind('_');
+    if (status_begin == std::string::npos || status_begin == 0) {
+      return {};
+    }
+    const auto type_begin = test_name.rfind('_', status_begin - 1);
+    if (type_begin == std::string::npos) {
+      return {};
+    }
+    return test_name.substr(type_begin + 1, status_begin - type_begin - 1);
+  }
+
+  // Input of this process according to the input residency of the task, see ppc::task::GetRankInputData()
+  template <typename Generator>
+  InType GetRankInputData(const Generator &generate) {
+    return ppc::task::GetRankInputData<InType>(
+        residency_, generate, [this](int rank, int num_ranks) { return GetTestInputDataOfRank(rank, num_ranks); });
+  }
+
+  // With PPC_PERF_CALIBRATION set, take the bandwidth ceiling from the machine calibration unless one was given
+  // explicitly; the calibration is measured collectively on the first test of the job. It covers the largest
+  // parallelism of the job rather than that of the current run, which a thread sweep narrows.
+  void ApplyCalibration(ppc::performance::PerfAttr &perf_attr) {
+    if (!IsPerfCalibrationEnabled()) {
+      return;
+    }
+    const auto &calibration = ppc::performance::GetCalibration(GetMPISize() * max_num_threads_);
+    if (perf_attr.peak_bandwidth_gbs == 0.0) {
+      perf_attr.peak_bandwidth_gbs = calibration.PeakBandwidthGbs(GetTaskParallelism());
+    }
+  }
+
+  // Number of hardware threads the task occupies on the job
+  int GetTaskParallelism() {
+    const auto type = task_->GetDynamicTypeOfTask();
+    if (type == ppc::task::TypeOfTask::kSEQ) {
+      return 1;
+    }
+    if (type == ppc::task::TypeOfTask::kMPI) {
+      return GetMPISize();
+    }
+    if (type == ppc::task::TypeOfTask::kALL) {
+      return GetMPISize() * GetNumThreads();
+    }
+    return GetNumThreads();
+  }
+
+  // Append a structured record of the run to the file named by PPC_PERF_RESULTS_FILE, if any
+  void WriteResultsFile(const std::string &test_name, const ppc::performance::PerfResults &perf_results) {
+    const auto results_file = GetPerfResultsFile();
+    if (results_file.empty()) {
+      return;
+    }
+    const ppc::performance::PerfRunInfo info{.test_id = test_name,
+                                             .type_of_task = task_->GetDynamicTypeOfTask(),
+                                             .num_procs = GetMPISize(),
+                                             .num_threads = GetNumThreads()};
+    ppc::performance::AppendPerfResults(results_file, info, perf_results);
+  }
+
   ppc::task::TaskPtr<InType, OutType> task_;
+  std::vector<int> thread_sweep_;
+  // Whether the test runs the sequential implementation, the reference of the thread sweep
+  bool is_sweep_reference_ = false;
+  int max_num_threads_ = 1;
+  ppc::task::InputResidency residency_ = ppc::task::InputResidency::kReplicated;
 };
 
 template <typename TaskType, typename InputType>
@@ -112,9 +340,11 @@ auto MakePerfTaskTuples(const std::string &settings_path) {
                     ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
 
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kPipeline),
+                                         ppc::performance::PerfResults::TypeOfRunning::kPipeline,
+                                         TaskType::GetStaticInputResidency()),
                          std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
-                                         ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
+                                         ppc::performance::PerfResults::TypeOfRunning::kTaskRun,
+                                         TaskType::GetStaticInputResidency()));
 }
 
 template <typename Tuple, std::size_t... I>
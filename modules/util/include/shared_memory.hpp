@@ -0,0 +1,87 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace ppc::util {
+
+/// @brief Buffer mapped into the address space of every process of one node, see MPI_Win_allocate_shared().
+/// @details The processes of @p comm are grouped by node with MPI_Comm_split_type(MPI_COMM_TYPE_SHARED). Only the
+/// first process of each node, its leader, allocates memory; the others access the leader's buffer through plain loads
+/// and stores, so a node keeps one copy of the data however many processes it runs.
+class NodeSharedMemory {
+ public:
+  NodeSharedMemory() = default;
+
+  /// @brief Allocates @p bytes once per node; collective over @p comm.
+  /// @param root Process of @p comm that leads its node and is process 0 of LeaderComm().
+  NodeSharedMemory(std::size_t bytes, int root, MPI_Comm comm);
+
+  NodeSharedMemory(const NodeSharedMemory &) = delete;
+  NodeSharedMemory &operator=(const NodeSharedMemory &) = delete;
+  NodeSharedMemory(NodeSharedMemory &&other) noexcept;
+  NodeSharedMemory &operator=(NodeSharedMemory &&other) noexcept;
+  ~NodeSharedMemory();
+
+  /// @brief Shared buffer; writes have to be followed by Synchronize() before other processes read them.
+  [[nodiscard]] std::span<std::byte> Bytes() const {
+    return {data_, size_};
+  }
+
+  /// @brief Shared buffer viewed as elements of type T.
+  template <typename T>
+  [[nodiscard]] std::span<const T> As() const {
+    static_assert(std::is_trivially_copyable_v<T>, "Shared memory holds trivially copyable elements");
+    return {reinterpret_cast<const T *>(data_), size_ / sizeof(T)};
+  }
+
+  /// @brief Whether this process allocated the buffer of its node.
+  [[nodiscard]] bool IsLeader() const {
+    return leader_comm_ != MPI_COMM_NULL;
+  }
+
+  /// @brief Processes that share the buffer with this one.
+  [[nodiscard]] MPI_Comm NodeComm() const {
+    return node_comm_;
+  }
+
+  /// @brief Leaders of all nodes on the leaders, MPI_COMM_NULL on the other processes.
+  [[nodiscard]] MPI_Comm LeaderComm() const {
+    return leader_comm_;
+  }
+
+  /// @brief Window of the buffer over NodeComm(); MPI_WIN_NULL once the buffer is released.
+  [[nodiscard]] MPI_Win Window() const {
+    return window_;
+  }
+
+  /// @brief Makes preceding writes into the buffer visible to the node; collective over NodeComm().
+  void Synchronize() const;
+
+ private:
+  void Release();
+
+  MPI_Comm node_comm_ = MPI_COMM_NULL;
+  MPI_Comm leader_comm_ = MPI_COMM_NULL;
+  MPI_Win window_ = MPI_WIN_NULL;
+  std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+/// @brief Copies @p data from @p root into a NodeSharedMemory on every node.
+/// @details Collective over @p comm; @p data is only read on @p root. The root copies it into the buffer of its node,
+/// and the leaders of the other nodes receive it through a broadcast among themselves. The processes then read the
+/// blocks they need in place instead of receiving private copies through MPI_Scatterv.
+NodeSharedMemory ShareBytesWithNodes(std::span<const std::byte> data, int root, MPI_Comm comm);
+
+/// @brief ShareBytesWithNodes() for elements of type T; read them back with NodeSharedMemory::As<T>().
+template <typename T>
+NodeSharedMemory ShareWithNodes(std::span<const T> data, int root = 0, MPI_Comm comm = MPI_COMM_WORLD) {
+  static_assert(std::is_trivially_copyable_v<T>, "Shared memory holds trivially copyable elements");
+  return ShareBytesWithNodes(std::as_bytes(data), root, comm);
+}
+
+}  // namespace ppc::util
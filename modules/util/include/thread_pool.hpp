@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "util/include/partition.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Pool of worker threads that stay alive between parallel regions.
+/// @details Every worker owns a queue of jobs. A worker takes the newest job of its own queue and, once that is empty,
+/// steals the oldest job of another worker, so nested parallelism stays local while idle workers balance the load.
+/// Workers are only started on demand and never exceed kMaxWorkers.
+class ThreadPool {
+ public:
+  static constexpr int kMaxWorkers = 256;
+
+  /// @brief Pool shared by all tasks of the process.
+  static ThreadPool &Global();
+
+  ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+  /// @brief Stops the workers once their queues are empty.
+  ~ThreadPool();
+
+  /// @brief Starts workers until there are at least @p num_workers of them.
+  void Reserve(int num_workers);
+
+  [[nodiscard]] int NumWorkers() const {
+    return num_workers_.load(std::memory_order_acquire);
+  }
+
+  /// @brief Queues @p job, which must not throw; a pool without workers runs it right away on the calling thread.
+  void Submit(std::function<void()> job);
+
+  /// @brief Runs one queued job on the calling thread, preferring the own queue of a worker.
+  /// @return Whether a job was run.
+  bool RunPendingJob();
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> jobs;
+  };
+
+  bool TryPop(std::function<void()> &job);
+  void WorkerLoop(int index);
+
+  // Allocated up front, so that workers can steal while the pool grows
+  std::vector<Worker> workers_;
+  std::vector<std::thread> threads_;
+  std::mutex threads_mutex_;
+  std::atomic<int> num_workers_ = 0;
+  std::atomic<std::size_t> next_worker_ = 0;
+  std::atomic<std::size_t> pending_ = 0;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+};
+
+/// @brief Set of jobs on a ThreadPool that can be waited for together.
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool &pool = ThreadPool::Global()) : pool_(pool) {}
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  TaskGroup(TaskGroup &&) = delete;
+  TaskGroup &operator=(TaskGroup &&) = delete;
+  /// @brief Waits for the jobs; exceptions that Wait() has not reported are dropped.
+  ~TaskGroup();
+
+  /// @brief Queues @p job on the pool of the group.
+  template <typename Job>
+  void Run(Job &&job) {
+    {
+      const std::scoped_lock lock(mutex_);
+      pending_++;
+    }
+    pool_.Submit([this, job = std::forward<Job>(job)]() mutable {
+      std::exception_ptr error;
+      try {
+        job();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      Finish(error);
+    });
+  }
+
+  /// @brief Runs queued jobs of the pool until all jobs of this group are done.
+  /// @throws Rethrows the first exception thrown by a job of the group.
+  void Wait();
+
+ private:
+  void Finish(const std::exception_ptr &error);
+  void WaitForJobs();
+
+  ThreadPool &pool_;
+  // Guards all members below; a finished job notifies under it, so the group outlives every notification
+  std::mutex mutex_;
+  std::condition_variable done_;
+  std::size_t pending_ = 0;
+  std::exception_ptr error_;
+};
+
+/// @brief Number of blocks that ParallelFor() and ParallelReduce() cut @p count indices into.
+/// @details A few blocks per thread let idle threads steal work when iterations take uneven time.
+std::size_t CountParallelChunks(std::size_t count, int num_threads);
+
+/// @brief Calls @p body(chunk) for every chunk in [0, @p num_chunks) on @p num_threads threads of the global pool.
+/// @details The calling thread and up to @p num_threads - 1 jobs on the pool take chunks one after another, so a pool
+/// with more workers than @p num_threads does not run more threads than requested.
+void RunParallelChunks(std::size_t num_chunks, int num_threads, const std::function<void(std::size_t)> &body);
+
+/// @brief Calls @p body(i) for every i in [@p begin, @p end) on GetNumThreads() threads of the global pool.
+template <typename Body>
+void ParallelFor(std::size_t begin, std::size_t end, const Body &body) {
+  const std::size_t count = end > begin ? end - begin : 0;
+  const int num_threads = GetNumThreads();
+  const std::size_t num_chunks = CountParallelChunks(count, num_threads);
+  RunParallelChunks(num_chunks, num_threads, [&](std::size_t chunk) {
+    const auto range = GetBlockRange(count, static_cast<int>(chunk), static_cast<int>(num_chunks));
+    for (std::size_t i = begin + range.begin; i < begin + range.end; i++) {
+      body(i);
+    }
+  });
+}
+
+/// @brief Reduces [@p begin, @p end) on GetNumThreads() threads of the global pool.
+/// @param identity Neutral element of @p combine; the result of an empty range.
+/// @param body Callable as T(BlockRange range, T acc) that folds the indices of a block into @p acc.
+/// @param combine Associative callable as T(T, T). Partial results are combined in index order, so the result does not
+/// depend on the scheduling.
+template <typename T, typename Body, typename Combine>
+T ParallelReduce(std::size_t begin, std::size_t end, T identity, const Body &body, const Combine &combine) {
+  // One cache line per partial result, so that threads do not write to the same line
+  struct alignas(64) Partial {
+    T value;
+  };
+  const std::size_t count = end > begin ? end - begin : 0;
+  const int num_threads = GetNumThreads();
+  const std::size_t num_chunks = CountParallelChunks(count, num_threads);
+  std::vector<Partial> partial(num_chunks, Partial{identity});
+  RunParallelChunks(num_chunks, num_threads, [&](std::size_t chunk) {
+    const auto range = GetBlockRange(count, static_cast<int>(chunk), static_cast<int>(num_chunks));
+    partial[chunk].value = body(BlockRange{.begin = begin + range.begin, .end = begin + range.end}, identity);
+  });
+  T result = identity;
+  for (auto &part : partial) {
+    result = combine(std::move(result), std::move(part.value));
+  }
+  return result;
+}
+
+}  // namespace ppc::util
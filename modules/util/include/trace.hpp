@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief One completed span of the execution timeline.
+struct TraceEvent {
+  /// @brief Span name shown on the timeline.
+  std::string name;
+  /// @brief Span category, e.g. "task" for pipeline stages.
+  std::string category;
+  /// @brief Start time in nanoseconds of Tracer::NowNs().
+  int64_t begin_ns = 0;
+  /// @brief End time in nanoseconds of Tracer::NowNs().
+  int64_t end_ns = 0;
+};
+
+/// @brief Process-wide recorder of timeline spans exported in the Chrome Trace Event format.
+/// @details Every thread appends to its own buffer, so recording takes no lock; only the first span of a thread
+/// registers its buffer under a mutex. Serialization and Clear() must not run concurrently with recording.
+class Tracer {
+ public:
+  /// @brief Starts recording spans.
+  static void Enable() {
+    enabled.store(true, std::memory_order_relaxed);
+  }
+
+  /// @brief Stops recording spans; already recorded spans are kept.
+  static void Disable() {
+    enabled.store(false, std::memory_order_relaxed);
+  }
+
+  /// @brief Checks whether spans are being recorded.
+  static bool IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Returns the monotonic time used for span timestamps in nanoseconds.
+  static int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /// @brief Appends a completed span to the buffer of the calling thread.
+  static void Record(std::string_view name, std::string_view category, int64_t begin_ns, int64_t end_ns) {
+    LocalBuffer().events.push_back(
+        {.name = std::string(name), .category = std::string(category), .begin_ns = begin_ns, .end_ns = end_ns});
+  }
+
+  /// @brief Removes the spans of all threads.
+  static void Clear();
+
+  /// @brief Returns the number of spans recorded by all threads.
+  static std::size_t Size();
+
+  /// @brief Serializes the spans of all threads as a JSON array of Chrome trace events.
+  /// @param pid Process id of the events, the MPI rank.
+  /// @param offset_ns Added to every timestamp to align the clock with other processes.
+  /// @return JSON array text including process and thread name metadata.
+  static std::string SerializeEvents(int pid, int64_t offset_ns);
+
+  /// @brief Writes a Chrome trace file from JSON arrays produced by SerializeEvents().
+  /// @param path Output file path.
+  /// @param event_arrays Serialized events of every process.
+  /// @throws std::runtime_error If the file cannot be written or an array is malformed.
+  static void WriteChromeTrace(const std::string &path, const std::vector<std::string> &event_arrays);
+
+ private:
+  struct ThreadBuffer {
+    int tid = 0;
+    std::vector<TraceEvent> events;
+  };
+
+  static ThreadBuffer &LocalBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = RegisterThread();
+    return *buffer;
+  }
+
+  static std::shared_ptr<ThreadBuffer> RegisterThread() {
+    const std::lock_guard<std::mutex> lock(registry_mutex);
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->tid = static_cast<int>(registry.size());
+    registry.push_back(buffer);
+    return buffer;
+  }
+
+  inline static std::atomic<bool> enabled{false};
+  inline static std::mutex registry_mutex;
+  inline static std::vector<std::shared_ptr<ThreadBuffer>> registry;
+};
+
+/// @brief Records the lifetime of the object as a span if tracing is enabled.
+/// @details The name and category are not copied until the span ends, so they must outlive it. Usable anywhere,
+/// e.g. around the scatter, compute and gather phases inside RunImpl():
+/// @code
+/// {
+///   ppc::util::TraceSpan span("scatter");
+///   MPI_Scatterv(...);
+/// }
+/// @endcode
+class TraceSpan {
+ public:
+  explicit TraceSpan(std::string_view name, std::string_view category = "user")
+      : name_(name), category_(category), begin_ns_(Tracer::IsEnabled() ? Tracer::NowNs() : -1) {}
+  ~TraceSpan() {
+    if (begin_ns_ >= 0) {
+      Tracer::Record(name_, category_, begin_ns_, Tracer::NowNs());
+    }
+  }
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+  TraceSpan(TraceSpan &&) = delete;
+  TraceSpan &operator=(TraceSpan &&) = delete;
+
+ private:
+  std::string_view name_;
+  std::string_view category_;
+  int64_t begin_ns_;
+};
+
+}  // namespace ppc::util
@@ -4,6 +4,7 @@
 #include <array>
 #include <atomic>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -13,6 +14,7 @@
 #include <string_view>
 #include <system_error>
 #include <typeinfo>
+#include <vector>
 #ifdef __GNUG__
 #  include <cxxabi.h>
 #endif
@@ -64,13 +66,66 @@ class DestructorFailureFlag {
   inline static std::atomic<bool> failure_flag{false};
 };
 
-enum class GTestParamIndex : uint8_t { kTaskGetter, kNameTest, kTestParams };
+/// @brief Pipeline stage that a task is currently executing on this process.
+enum class ActiveStage : uint8_t { kNone, kValidation, kPreProcessing, kRun, kPostProcessing };
+
+/// @brief Number of ActiveStage values.
+constexpr std::size_t kActiveStageCount = 5;
+
+/// @brief Publishes the pipeline stage in progress so that instrumentation layers can attribute their data.
+/// @details Updated by ppc::task::Task around every stage implementation.
+class ActiveStageTracker {
+ public:
+  /// @brief Marks @p stage as the one in progress.
+  static void Set(ActiveStage stage) {
+    active_stage.store(stage, std::memory_order_relaxed);
+  }
+
+  /// @brief Returns the stage in progress, or kNone outside of a task pipeline.
+  static ActiveStage Get() {
+    return active_stage.load(std::memory_order_relaxed);
+  }
+
+ private:
+  inline static std::atomic<ActiveStage> active_stage{ActiveStage::kNone};
+};
+
+/// @brief Returns a lowercase name of the stage; "other" for kNone.
+inline std::string_view GetActiveStageName(ActiveStage stage) {
+  constexpr std::array<std::string_view, kActiveStageCount> kNames = {"other", "validation", "preprocessing", "run",
+                                                                     "postprocessing"};
+  return kNames.at(static_cast<std::size_t>(stage));
+}
+
+enum class GTestParamIndex : uint8_t { kTaskGetter, kNameTest, kTestParams, kInputResidency };
 
 std::string GetAbsoluteTaskPath(const std::string &id_path, const std::string &relative_path);
 int GetNumThreads();
 int GetNumProc();
+/// @brief Rank in MPI_COMM_WORLD, or 0 if MPI is not running.
+int GetMPIRank();
+/// @brief Size of MPI_COMM_WORLD, or 1 if MPI is not running.
+int GetMPISize();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
+int GetPerfWarmupRuns();
+bool IsPerfAdaptive();
+bool IsPerfHwCountersEnabled();
+std::string GetPerfResultsFile();
+std::string GetPerfBaselineFile();
+double GetPerfRegressionMargin();
+double GetPerfPeakBandwidth();
+bool IsPerfCalibrationEnabled();
+std::vector<int> GetPerfThreadSweep();
+/// @brief Largest thread count a run of the job can use: GetNumThreads() or, if larger, the largest count of
+/// GetPerfThreadSweep().
+int GetMaxNumThreads();
+bool IsPerfSizeSweepEnabled();
+std::string GetTraceFile();
+/// @brief Whether the collectives of collectives.hpp agree on failed argument checks across processes, see
+/// ScattervBytes().
+bool IsCollectiveCheckEnabled();
+std::string GetHostName();
 
 template <typename T>
 std::string GetNamespace() {
@@ -0,0 +1,148 @@
+#include "util/include/binary_file.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// MPI counts are int, so large ranges are read in several collective calls
+constexpr std::size_t kMpiIoChunkBytes = std::size_t{1} << 30;
+
+template <typename Dim>
+std::vector<std::size_t> ReadDims(std::ifstream &file, std::size_t num_dims) {
+  std::vector<std::size_t> dims(num_dims);
+  for (auto &dim : dims) {
+    Dim value{};
+    file.read(reinterpret_cast<char *>(&value), sizeof(Dim));
+    if (!file || value < 1) {
+      return {};
+    }
+    dim = static_cast<std::size_t>(value);
+  }
+  return dims;
+}
+
+bool IsMpiActive() {
+  int is_initialized = 0;
+  int is_finalized = 0;
+  MPI_Initialized(&is_initialized);
+  MPI_Finalized(&is_finalized);
+  return is_initialized != 0 && is_finalized == 0;
+}
+
+// Whether @p ok holds on every process, so that they all throw together instead of some of them waiting in the next
+// collective call for the ones that threw
+bool HoldsOnAllProcesses(bool ok) {
+  if (!IsMpiActive()) {
+    return ok;
+  }
+  int value = ok ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  return value != 0;
+}
+
+void ReadWithStream(const std::string &path, std::size_t offset, std::span<std::byte> buffer) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  file.seekg(static_cast<std::streamoff>(offset));
+  file.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+  if (std::cmp_not_equal(file.gcount(), buffer.size())) {
+    throw std::runtime_error("Unexpected end of " + path);
+  }
+}
+
+void ReadWithMpiIo(const std::string &path, std::size_t offset, std::span<std::byte> buffer) {
+  MPI_File file = MPI_FILE_NULL;
+  const bool is_open =
+      MPI_File_open(MPI_COMM_WORLD, path.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) == MPI_SUCCESS;
+  if (!HoldsOnAllProcesses(is_open)) {
+    // Closing is collective as well, so a handle that only some processes got is left open rather than waited on
+    throw std::runtime_error("Failed to open " + path);
+  }
+  // Every process has to take part in every collective read, also after its own range is done
+  auto num_chunks = static_cast<std::uint64_t>((buffer.size() + kMpiIoChunkBytes - 1) / kMpiIoChunkBytes);
+  MPI_Allreduce(MPI_IN_PLACE, &num_chunks, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+
+  bool is_complete = true;
+  std::size_t done = 0;
+  for (std::uint64_t chunk = 0; chunk < num_chunks; chunk++) {
+    const std::size_t count = std::min(kMpiIoChunkBytes, buffer.size() - done);
+    MPI_Status status;
+    const int res = MPI_File_read_at_all(file, static_cast<MPI_Offset>(offset + done), buffer.data() + done,
+                                         static_cast<int>(count), MPI_BYTE, &status);
+    int received = 0;
+    MPI_Get_count(&status, MPI_BYTE, &received);
+    is_complete = is_complete && res == MPI_SUCCESS && std::cmp_equal(received, count);
+    done += count;
+  }
+  MPI_File_close(&file);
+  if (!HoldsOnAllProcesses(is_complete)) {
+    throw std::runtime_error("Unexpected end of " + path);
+  }
+}
+
+}  // namespace
+
+std::size_t ppc::util::BinaryFileHeader::RowSize() const {
+  std::size_t size = 1;
+  for (std::size_t i = 1; i < dims.size(); i++) {
+    size *= dims[i];
+  }
+  return size;
+}
+
+ppc::util::BinaryFileHeader ppc::util::ReadBinaryFileHeader(const std::string &path, BinaryHeaderType type,
+                                                            std::size_t num_dims) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  BinaryFileHeader header;
+  if (type == BinaryHeaderType::kInt32) {
+    header.dims = ReadDims<std::int32_t>(file, num_dims);
+    header.data_offset = num_dims * sizeof(std::int32_t);
+  } else {
+    header.dims = ReadDims<std::uint64_t>(file, num_dims);
+    header.data_offset = num_dims * sizeof(std::uint64_t);
+  }
+  if (num_dims == 0 || header.dims.empty()) {
+    throw std::runtime_error("Invalid header in " + path);
+  }
+  return header;
+}
+
+ppc::util::BinaryFileHeader ppc::util::ReadBinaryFileHeaderCollective(const std::string &path, BinaryHeaderType type,
+                                                                      std::size_t num_dims) {
+  std::optional<BinaryFileHeader> header;
+  std::string error = "Failed to read the header of " + path + " on another process";
+  try {
+    header = ReadBinaryFileHeader(path, type, num_dims);
+  } catch (const std::runtime_error &e) {
+    error = e.what();
+  }
+  if (!HoldsOnAllProcesses(header.has_value())) {
+    throw std::runtime_error(error);
+  }
+  return *std::move(header);
+}
+
+void ppc::util::ReadBinaryFileBytes(const std::string &path, std::size_t offset, std::span<std::byte> buffer) {
+  if (!IsMpiActive()) {
+    ReadWithStream(path, offset, buffer);
+    return;
+  }
+  ReadWithMpiIo(path, offset, buffer);
+}
@@ -0,0 +1,378 @@
+#include "util/include/collectives.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/matrix.hpp"
+#include "util/include/mpi_types.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+constexpr auto kIntMax = static_cast<std::size_t>(std::numeric_limits<int>::max());
+constexpr int kLargeTransferTag = 4242;
+
+struct IntPartition {
+  std::vector<int> counts;
+  std::vector<int> displs;
+};
+
+// Counts and offsets in units of `scale` bytes, if all of them fit into `max_count`
+std::optional<IntPartition> ToIntPartition(const ppc::util::BlockPartition &partition, std::size_t scale,
+                                           std::size_t max_count = kIntMax) {
+  IntPartition result{.counts = std::vector<int>(partition.counts.size()),
+                      .displs = std::vector<int>(partition.displs.size())};
+  for (std::size_t r = 0; r < partition.counts.size(); r++) {
+    if (partition.counts[r] * scale > max_count || partition.displs[r] * scale > max_count) {
+      return std::nullopt;
+    }
+    result.counts[r] = static_cast<int>(partition.counts[r] * scale);
+    result.displs[r] = static_cast<int>(partition.displs[r] * scale);
+  }
+  return result;
+}
+
+// Runs a single collective call in bytes or, if byte offsets overflow int, in whole elements.
+// Returns false if even element counts overflow, so that the caller has to split the transfer.
+template <typename Collective>
+bool RunIntCollective(const ppc::util::BlockPartition &partition, std::size_t elem_size,
+                      const ppc::util::TransferLimits &limits, Collective collective) {
+  if (const auto bytes = ToIntPartition(partition, elem_size, limits.max_count)) {
+    collective(*bytes, MPI_BYTE);
+    return true;
+  }
+  if (const auto elems = ToIntPartition(partition, 1, limits.max_count)) {
+    const auto type = ppc::util::MakeContiguousType(elem_size, MPI_BYTE);
+    collective(*elems, type.Get());
+    return true;
+  }
+  return false;
+}
+
+// Calls post(offset, count, type) for whole pieces of `bytes` and then for the remaining bytes
+template <typename Post>
+void ForEachPiece(std::size_t bytes, std::size_t piece_bytes, MPI_Datatype piece, Post post) {
+  const std::size_t pieces = bytes / piece_bytes;
+  if (pieces > 0) {
+    post(std::size_t{0}, static_cast<int>(pieces), piece);
+  }
+  if (bytes % piece_bytes > 0) {
+    post(pieces * piece_bytes, static_cast<int>(bytes % piece_bytes), MPI_BYTE);
+  }
+}
+
+std::span<const std::byte> BlockOf(std::span<const std::byte> data, const ppc::util::BlockPartition &partition, int r,
+                                   std::size_t elem_size) {
+  const auto range = partition.Range(r);
+  return data.subspan(range.begin * elem_size, range.Size() * elem_size);
+}
+
+std::span<std::byte> BlockOf(std::span<std::byte> data, const ppc::util::BlockPartition &partition, int r,
+                             std::size_t elem_size) {
+  const auto range = partition.Range(r);
+  return data.subspan(range.begin * elem_size, range.Size() * elem_size);
+}
+
+void ScatterLarge(std::span<const std::byte> send, const ppc::util::BlockPartition &partition,
+                  std::span<std::byte> recv, std::size_t elem_size, int root, MPI_Comm comm,
+                  const ppc::util::TransferLimits &limits) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const auto piece = ppc::util::MakeContiguousType(limits.piece_bytes, MPI_BYTE);
+  std::vector<MPI_Request> requests;
+  if (rank == root) {
+    for (int r = 0; r < size; r++) {
+      const auto block = BlockOf(send, partition, r, elem_size);
+      if (r == root) {
+        std::ranges::copy(block, recv.begin());
+        continue;
+      }
+      ForEachPiece(block.size(), limits.piece_bytes, piece.Get(),
+                   [&](std::size_t offset, int count, MPI_Datatype type) {
+                     MPI_Isend(block.data() + offset, count, type, r, kLargeTransferTag, comm,
+                               &requests.emplace_back());
+                   });
+    }
+  } else {
+    const std::size_t bytes = partition.counts[rank] * elem_size;
+    ForEachPiece(bytes, limits.piece_bytes, piece.Get(), [&](std::size_t offset, int count, MPI_Datatype type) {
+      MPI_Irecv(recv.data() + offset, count, type, root, kLargeTransferTag, comm, &requests.emplace_back());
+    });
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+void GatherLarge(std::span<const std::byte> send, const ppc::util::BlockPartition &partition,
+                 std::span<std::byte> recv, std::size_t elem_size, int root, MPI_Comm comm,
+                 const ppc::util::TransferLimits &limits) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const auto piece = ppc::util::MakeContiguousType(limits.piece_bytes, MPI_BYTE);
+  std::vector<MPI_Request> requests;
+  const auto own = send.first(partition.counts[rank] * elem_size);
+  if (rank == root) {
+    for (int r = 0; r < size; r++) {
+      const auto block = BlockOf(recv, partition, r, elem_size);
+      if (r == root) {
+        std::ranges::copy(own, block.begin());
+        continue;
+      }
+      ForEachPiece(block.size(), limits.piece_bytes, piece.Get(),
+                   [&](std::size_t offset, int count, MPI_Datatype type) {
+                     MPI_Irecv(block.data() + offset, count, type, r, kLargeTransferTag, comm,
+                               &requests.emplace_back());
+                   });
+    }
+  } else {
+    ForEachPiece(own.size(), limits.piece_bytes, piece.Get(), [&](std::size_t offset, int count, MPI_Datatype type) {
+      MPI_Isend(own.data() + offset, count, type, root, kLargeTransferTag, comm, &requests.emplace_back());
+    });
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+// Collects the failed argument checks of one process. A failed check is a programming error, so by default only the
+// failing process throws; with IsCollectiveCheckEnabled() all processes agree on it first and throw together, at the
+// cost of one more synchronizing collective per call
+class ArgumentCheck {
+ public:
+  explicit ArgumentCheck(MPI_Comm comm) : comm_(comm) {}
+
+  // Whether the partition matches the communicator, i.e. whether the counts of this process can be looked up
+  bool Partition(const ppc::util::BlockPartition &partition) {
+    int size = 0;
+    MPI_Comm_size(comm_, &size);
+    if (partition.counts.size() != static_cast<std::size_t>(size) ||
+        partition.displs.size() != partition.counts.size()) {
+      Fail("Block partition does not match the number of processes");
+      return false;
+    }
+    return true;
+  }
+
+  void Buffer(std::span<const std::byte> buffer, std::size_t elems, std::size_t elem_size) {
+    if (buffer.size() < elems * elem_size) {
+      Fail("Buffer is smaller than its part of the block partition");
+    }
+  }
+
+  void ThrowIfFailed() const {
+    int failed = error_ != nullptr ? 1 : 0;
+    if (ppc::util::IsCollectiveCheckEnabled()) {
+      MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm_);
+    }
+    if (failed != 0) {
+      throw std::invalid_argument(error_ != nullptr ? error_ : "Invalid arguments on another process");
+    }
+  }
+
+ private:
+  void Fail(const char *error) {
+    if (error_ == nullptr) {
+      error_ = error;
+    }
+  }
+
+  MPI_Comm comm_;
+  const char *error_ = nullptr;
+};
+
+}  // namespace
+
+void ppc::util::ScattervBytes(std::span<const std::byte> send, const BlockPartition &partition,
+                              std::span<std::byte> recv, std::size_t elem_size, int root, MPI_Comm comm,
+                              const TransferLimits &limits) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  ArgumentCheck check(comm);
+  if (check.Partition(partition)) {
+    check.Buffer(send, rank == root ? partition.Total() : 0, elem_size);
+    check.Buffer(recv, partition.counts[rank], elem_size);
+  }
+  check.ThrowIfFailed();
+
+  const bool done =
+      RunIntCollective(partition, elem_size, limits, [&](const IntPartition &counts, MPI_Datatype type) {
+        MPI_Scatterv(send.data(), counts.counts.data(), counts.displs.data(), type, recv.data(), counts.counts[rank],
+                     type, root, comm);
+      });
+  if (!done) {
+    ScatterLarge(send, partition, recv, elem_size, root, comm, limits);
+  }
+}
+
+void ppc::util::GathervBytes(std::span<const std::byte> send, const BlockPartition &partition,
+                             std::span<std::byte> recv, std::size_t elem_size, int root, MPI_Comm comm,
+                             const TransferLimits &limits) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  ArgumentCheck check(comm);
+  if (check.Partition(partition)) {
+    check.Buffer(send, partition.counts[rank], elem_size);
+    check.Buffer(recv, rank == root ? partition.Total() : 0, elem_size);
+  }
+  check.ThrowIfFailed();
+
+  const bool done =
+      RunIntCollective(partition, elem_size, limits, [&](const IntPartition &counts, MPI_Datatype type) {
+        MPI_Gatherv(send.data(), counts.counts[rank], type, recv.data(), counts.counts.data(), counts.displs.data(),
+                    type, root, comm);
+      });
+  if (!done) {
+    GatherLarge(send, partition, recv, elem_size, root, comm, limits);
+  }
+}
+
+void ppc::util::AllgathervBytes(std::span<const std::byte> send, const BlockPartition &partition,
+                                std::span<std::byte> recv, std::size_t elem_size, MPI_Comm comm,
+                                const TransferLimits &limits) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  ArgumentCheck check(comm);
+  if (check.Partition(partition)) {
+    check.Buffer(send, partition.counts[rank], elem_size);
+    check.Buffer(recv, partition.Total(), elem_size);
+  }
+  check.ThrowIfFailed();
+
+  const bool done =
+      RunIntCollective(partition, elem_size, limits, [&](const IntPartition &counts, MPI_Datatype type) {
+        MPI_Allgatherv(send.data(), counts.counts[rank], type, recv.data(), counts.counts.data(),
+                       counts.displs.data(), type, comm);
+      });
+  if (!done) {
+    // Gathering on one process and broadcasting from there keeps every message count within the limit
+    GatherLarge(send, partition, recv, elem_size, 0, comm, limits);
+    BcastBytes(recv.first(partition.Total() * elem_size), 0, comm, limits);
+  }
+}
+
+void ppc::util::BcastBytes(std::span<std::byte> data, int root, MPI_Comm comm, const TransferLimits &limits) {
+  if (data.size() <= limits.max_count) {
+    MPI_Bcast(data.data(), static_cast<int>(data.size()), MPI_BYTE, root, comm);
+    return;
+  }
+  const auto piece = MakeContiguousType(limits.piece_bytes, MPI_BYTE);
+  ForEachPiece(data.size(), limits.piece_bytes, piece.Get(), [&](std::size_t offset, int count, MPI_Datatype type) {
+    MPI_Bcast(data.data() + offset, count, type, root, comm);
+  });
+}
+
+void ppc::util::PipelinedScattervBytes(std::span<const std::byte> send, const BlockPartition &partition,
+                                       std::size_t elem_size, std::size_t chunk_elems,
+                                       const std::function<void(std::span<const std::byte>)> &consume, int root,
+                                       MPI_Comm comm, const TransferLimits &limits) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  ArgumentCheck check(comm);
+  if (check.Partition(partition)) {
+    check.Buffer(send, rank == root ? partition.Total() : 0, elem_size);
+  }
+  check.ThrowIfFailed();
+
+  // Counts and offsets are in bytes where they fit into limits.max_count, otherwise in whole elements
+  chunk_elems = std::clamp<std::size_t>(chunk_elems, 1, limits.max_count);
+  const std::size_t max_displ = std::ranges::max(partition.displs);
+  const bool in_bytes = max_displ * elem_size <= limits.max_count && chunk_elems * elem_size <= limits.max_count;
+  if (!in_bytes && max_displ > limits.max_count) {
+    throw std::invalid_argument("Block offset exceeds the largest count of one MPI call");
+  }
+  const std::size_t unit = in_bytes ? elem_size : 1;
+  const MpiDatatype element = in_bytes ? MpiDatatype() : MakeContiguousType(elem_size, MPI_BYTE);
+  const MPI_Datatype type = in_bytes ? MPI_BYTE : element.Get();
+
+  std::vector<int> displs(partition.displs.size());
+  for (std::size_t r = 0; r < displs.size(); r++) {
+    displs[r] = static_cast<int>(partition.displs[r] * unit);
+  }
+  const std::size_t own_chunk = std::min(chunk_elems, partition.counts[rank]);
+  const std::size_t rounds = (std::ranges::max(partition.counts) + chunk_elems - 1) / chunk_elems;
+
+  // MPI must not see the counts of a round change until it completes, so each buffer has its own
+  std::array<std::vector<std::byte>, 2> buffers;
+  std::array<std::vector<int>, 2> counts;
+  std::array<MPI_Request, 2> requests = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+  for (std::size_t slot = 0; slot < 2; slot++) {
+    buffers[slot].resize(own_chunk * elem_size);
+    counts[slot].resize(static_cast<std::size_t>(size));
+  }
+
+  const auto post = [&](std::size_t round) {
+    const std::size_t slot = round % 2;
+    const std::size_t begin = round * chunk_elems;
+    for (std::size_t r = 0; r < counts[slot].size(); r++) {
+      const std::size_t left = partition.counts[r] > begin ? partition.counts[r] - begin : 0;
+      counts[slot][r] = static_cast<int>(std::min(left, chunk_elems) * unit);
+    }
+    // Shifting the base keeps the offsets of all rounds equal to those of the blocks
+    const std::byte *base = rank == root ? send.data() + (begin * elem_size) : nullptr;
+    MPI_Iscatterv(base, counts[slot].data(), displs.data(), type, buffers[slot].data(), counts[slot][rank], type, root,
+                  comm, &requests[slot]);
+  };
+
+  if (rounds > 0) {
+    post(0);
+  }
+  for (std::size_t round = 0; round < rounds; round++) {
+    if (round + 1 < rounds) {
+      post(round + 1);
+    }
+    const std::size_t slot = round % 2;
+    MPI_Wait(&requests[slot], MPI_STATUS_IGNORE);
+    const auto received = static_cast<std::size_t>(counts[slot][rank]) / unit * elem_size;
+    if (received > 0) {
+      consume(std::span<const std::byte>(buffers[slot]).first(received));
+    }
+  }
+}
+
+void ppc::util::ScatterColumnBlocks(std::span<const std::byte> send, MatrixLayout layout, std::size_t rows,
+                                    std::size_t cols, const BlockPartition &columns, std::span<std::byte> recv,
+                                    MPI_Datatype type, int root, MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  int type_size = 0;
+  MPI_Type_size(type, &type_size);
+  const auto elem_size = static_cast<std::size_t>(type_size);
+  ArgumentCheck check(comm);
+  if (check.Partition(columns)) {
+    check.Buffer(send, rank == root ? rows * cols : 0, elem_size);
+    check.Buffer(recv, columns.counts[rank] * rows, elem_size);
+  }
+  check.ThrowIfFailed();
+  if (rows == 0 || cols == 0) {
+    return;
+  }
+  // The same on all processes, so they all throw together
+  const auto counts = ToIntPartition(columns, 1);
+  if (!counts || rows > kIntMax || cols > kIntMax) {
+    throw std::invalid_argument("Matrix dimension exceeds INT_MAX");
+  }
+
+  // Both sides count whole columns, so no count grows with the number of rows
+  const auto column = MakeContiguousType(rows, type);
+  MpiDatatype strided_column;
+  MPI_Datatype send_type = column.Get();
+  if (rank == root && layout == MatrixLayout::kRowMajor) {
+    strided_column = MakeColumnType(rows, cols, type);
+    send_type = strided_column.Get();
+  }
+  MPI_Scatterv(send.data(), counts->counts.data(), counts->displs.data(), send_type, recv.data(),
+               counts->counts[rank], column.Get(), root, comm);
+}
@@ -6,8 +6,38 @@ double ppc::util::GetTimeMPI() {
   return MPI_Wtime();
 }
 
+namespace {
+
+bool IsMpiActive() {
+  int is_initialized = 0;
+  int is_finalized = 0;
+  MPI_Initialized(&is_initialized);
+  MPI_Finalized(&is_finalized);
+  return is_initialized != 0 && is_finalized == 0;
+}
+
+}  // namespace
+
 int ppc::util::GetMPIRank() {
+  if (!IsMpiActive()) {
+    return 0;
+  }
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   return rank;
 }
+
+int ppc::util::GetMPISize() {
+  if (!IsMpiActive()) {
+    return 1;
+  }
+  int size = -1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+bool ppc::util::BcastRootDecisionMPI(bool decision) {
+  int flag = decision ? 1 : 0;
+  MPI_Bcast(&flag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return flag != 0;
+}
@@ -0,0 +1,120 @@
+#include "util/include/mapped_file.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+#if !defined(_WIN32)
+int ToMadvise(ppc::util::MapAdvice advice) {
+  if (advice == ppc::util::MapAdvice::kSequential) {
+    return MADV_SEQUENTIAL;
+  }
+  if (advice == ppc::util::MapAdvice::kRandom) {
+    return MADV_RANDOM;
+  }
+  if (advice == ppc::util::MapAdvice::kWillNeed) {
+    return MADV_WILLNEED;
+  }
+#  if defined(MADV_HUGEPAGE)
+  if (advice == ppc::util::MapAdvice::kHugePages) {
+    return MADV_HUGEPAGE;
+  }
+#  endif
+  return MADV_NORMAL;
+}
+#endif
+
+}  // namespace
+
+ppc::util::MappedFile::MappedFile(const std::string &path, MapAdvice advice) {
+#if defined(_WIN32)
+  std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  buffer_.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  struct stat info{};
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Failed to stat " + path);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Failed to map " + path);
+    }
+    data_ = static_cast<const std::byte *>(addr);
+    is_mapped_ = true;
+  }
+  // The mapping keeps the file alive on its own
+  close(fd);
+  Advise(advice);
+#endif
+}
+
+ppc::util::MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      is_mapped_(std::exchange(other.is_mapped_, false)),
+      buffer_(std::move(other.buffer_)) {}
+
+ppc::util::MappedFile &ppc::util::MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    is_mapped_ = std::exchange(other.is_mapped_, false);
+    buffer_ = std::move(other.buffer_);
+  }
+  return *this;
+}
+
+ppc::util::MappedFile::~MappedFile() {
+  Release();
+}
+
+void ppc::util::MappedFile::Advise(MapAdvice advice) const {
+#if !defined(_WIN32)
+  if (is_mapped_) {
+    // A hint only; kernels that reject it still serve the mapping
+    madvise(const_cast<std::byte *>(data_), size_, ToMadvise(advice));
+  }
+#else
+  (void)advice;
+#endif
+}
+
+void ppc::util::MappedFile::Release() {
+#if !defined(_WIN32)
+  if (is_mapped_) {
+    munmap(const_cast<std::byte *>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  is_mapped_ = false;
+  buffer_.clear();
+}
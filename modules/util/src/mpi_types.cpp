@@ -0,0 +1,106 @@
+#include "util/include/mpi_types.hpp"
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "util/include/matrix.hpp"
+#include "util/include/partition.hpp"
+
+namespace {
+
+int ToIntCount(std::size_t value) {
+  if (value > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+    throw std::invalid_argument("MPI datatype dimension exceeds INT_MAX");
+  }
+  return static_cast<int>(value);
+}
+
+MPI_Datatype Commit(MPI_Datatype type) {
+  MPI_Type_commit(&type);
+  return type;
+}
+
+// MPI releases all datatypes at MPI_Finalize and aborts on later calls, e.g. from destructors of globals
+void Free(MPI_Datatype &type) {
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (type != MPI_DATATYPE_NULL && finalized == 0) {
+    MPI_Type_free(&type);
+  }
+  type = MPI_DATATYPE_NULL;
+}
+
+}  // namespace
+
+ppc::util::MpiDatatype::MpiDatatype(MPI_Datatype type) : type_(Commit(type)) {}
+
+ppc::util::MpiDatatype::MpiDatatype(MpiDatatype &&other) noexcept
+    : type_(std::exchange(other.type_, MPI_DATATYPE_NULL)) {}
+
+ppc::util::MpiDatatype &ppc::util::MpiDatatype::operator=(MpiDatatype &&other) noexcept {
+  if (this != &other) {
+    Free(type_);
+    type_ = std::exchange(other.type_, MPI_DATATYPE_NULL);
+  }
+  return *this;
+}
+
+ppc::util::MpiDatatype::~MpiDatatype() {
+  Free(type_);
+}
+
+ppc::util::MpiDatatype ppc::util::MakeContiguousType(std::size_t count, MPI_Datatype base) {
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_contiguous(ToIntCount(count), base, &type);
+  return MpiDatatype(type);
+}
+
+ppc::util::MpiDatatype ppc::util::MakeColumnType(std::size_t rows, std::size_t row_stride, MPI_Datatype base) {
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+  MPI_Type_get_extent(base, &lower_bound, &extent);
+
+  MPI_Datatype column = MPI_DATATYPE_NULL;
+  MPI_Type_vector(ToIntCount(rows), 1, ToIntCount(row_stride), base, &column);
+  MPI_Datatype resized = MPI_DATATYPE_NULL;
+  MPI_Type_create_resized(column, 0, extent, &resized);
+  MPI_Type_free(&column);
+  return MpiDatatype(resized);
+}
+
+ppc::util::MpiDatatype ppc::util::MakeSubarrayType(std::size_t rows, std::size_t cols, const Block2D &block,
+                                                   MatrixLayout layout, MPI_Datatype base) {
+  const std::array<int, 2> sizes = {ToIntCount(rows), ToIntCount(cols)};
+  const std::array<int, 2> subsizes = {ToIntCount(block.rows.Size()), ToIntCount(block.cols.Size())};
+  const std::array<int, 2> starts = {ToIntCount(block.rows.begin), ToIntCount(block.cols.begin)};
+  const int order = layout == MatrixLayout::kRowMajor ? MPI_ORDER_C : MPI_ORDER_FORTRAN;
+
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_create_subarray(2, sizes.data(), subsizes.data(), starts.data(), order, base, &type);
+  return MpiDatatype(type);
+}
+
+MPI_Datatype ppc::util::CreatePersistentPairType(MPI_Datatype first, MPI_Aint first_offset, MPI_Datatype second,
+                                                 MPI_Aint second_offset, std::size_t extent) {
+  const std::array<int, 2> lengths = {1, 1};
+  const std::array<MPI_Aint, 2> offsets = {first_offset, second_offset};
+  const std::array<MPI_Datatype, 2> types = {first, second};
+  MPI_Datatype pair = MPI_DATATYPE_NULL;
+  MPI_Type_create_struct(2, lengths.data(), offsets.data(), types.data(), &pair);
+  // Trailing padding belongs to the element, so that arrays of pairs can be sent with a count
+  MPI_Datatype resized = MPI_DATATYPE_NULL;
+  MPI_Type_create_resized(pair, 0, static_cast<MPI_Aint>(extent), &resized);
+  MPI_Type_free(&pair);
+  return Commit(resized);
+}
+
+MPI_Datatype ppc::util::CreatePersistentBytesType(std::size_t size) {
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_contiguous(ToIntCount(size), MPI_BYTE, &type);
+  return Commit(type);
+}
@@ -0,0 +1,145 @@
+#include "util/include/numeric_text.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "util/include/mapped_file.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+// Below this size per thread, splitting costs more than it saves
+constexpr std::size_t kMinChunkBytes = std::size_t{1} << 20;
+
+template <typename T>
+struct ParsedChunk {
+  std::vector<T> values;
+  std::vector<std::size_t> row_sizes;
+  // Offset of the first invalid character in the whole text, or npos
+  std::size_t error_offset = std::string_view::npos;
+};
+
+bool IsSeparator(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == ';';
+}
+
+bool IsUnsignedNumberStart(char c) {
+  return (c >= '0' && c <= '9') || c == '.';
+}
+
+template <typename T>
+void ParseChunk(std::string_view text, std::size_t begin, std::size_t end, ParsedChunk<T> &chunk) {
+  const char *pos = text.data() + begin;
+  const char *last = text.data() + end;
+  std::size_t row_size = 0;
+  while (pos < last) {
+    if (*pos == '\n') {
+      if (row_size > 0) {
+        chunk.row_sizes.push_back(row_size);
+      }
+      row_size = 0;
+      ++pos;
+      continue;
+    }
+    if (IsSeparator(*pos)) {
+      ++pos;
+      continue;
+    }
+    // from_chars does not accept an explicit plus sign; skip it only in front of an unsigned number
+    const char *number = (*pos == '+' && pos + 1 < last && IsUnsignedNumberStart(pos[1])) ? pos + 1 : pos;
+    T value{};
+    const auto [next, ec] = std::from_chars(number, last, value);
+    if (ec != std::errc{}) {
+      chunk.error_offset = static_cast<std::size_t>(pos - text.data());
+      return;
+    }
+    // A number ends at a separator or line break, so that "12-3" is not read as two numbers
+    if (next < last && *next != '\n' && !IsSeparator(*next)) {
+      chunk.error_offset = static_cast<std::size_t>(next - text.data());
+      return;
+    }
+    chunk.values.push_back(value);
+    ++row_size;
+    pos = next;
+  }
+  if (row_size > 0) {
+    chunk.row_sizes.push_back(row_size);
+  }
+}
+
+// Chunk boundaries right after a line break, so that no row spans two chunks
+std::vector<std::size_t> SplitAtLines(std::string_view text, int num_chunks) {
+  std::vector<std::size_t> bounds = {0};
+  for (int k = 1; k < num_chunks; k++) {
+    const std::size_t target = std::max(bounds.back(), text.size() * static_cast<std::size_t>(k) / num_chunks);
+    const std::size_t line_end = text.find('\n', target);
+    bounds.push_back(line_end == std::string_view::npos ? text.size() : line_end + 1);
+  }
+  bounds.push_back(text.size());
+  return bounds;
+}
+
+}  // namespace
+
+template <typename T>
+ppc::util::NumericTable<T> ppc::util::ParseNumericText(std::string_view text, int num_threads) {
+  const int threads = num_threads > 0 ? num_threads : GetNumThreads();
+  const auto by_size = static_cast<int>(std::min<std::size_t>(text.size() / kMinChunkBytes, threads));
+  const int num_chunks = std::max(by_size, 1);
+  const auto bounds = SplitAtLines(text, num_chunks);
+
+  std::vector<ParsedChunk<T>> chunks(num_chunks);
+#pragma omp parallel for default(none) shared(text, bounds, chunks, num_chunks) num_threads(num_chunks)
+  for (int k = 0; k < num_chunks; k++) {
+    ParseChunk(text, bounds[k], bounds[k + 1], chunks[k]);
+  }
+
+  std::size_t num_values = 0;
+  std::size_t num_rows = 0;
+  for (const auto &chunk : chunks) {
+    if (chunk.error_offset != std::string_view::npos) {
+      throw std::runtime_error("Invalid number at offset " + std::to_string(chunk.error_offset));
+    }
+    num_values += chunk.values.size();
+    num_rows += chunk.row_sizes.size();
+  }
+
+  NumericTable<T> table;
+  table.values.resize(num_values);
+  table.row_offsets.reserve(num_rows + 1);
+  std::vector<std::size_t> value_offsets(num_chunks, 0);
+  for (int k = 0; k < num_chunks; k++) {
+    value_offsets[k] = table.row_offsets.back();
+    for (const std::size_t row_size : chunks[k].row_sizes) {
+      table.row_offsets.push_back(table.row_offsets.back() + row_size);
+    }
+  }
+#pragma omp parallel for default(none) shared(chunks, table, value_offsets, num_chunks) num_threads(num_chunks)
+  for (int k = 0; k < num_chunks; k++) {
+    std::copy(chunks[k].values.begin(), chunks[k].values.end(),
+              table.values.begin() + static_cast<std::ptrdiff_t>(value_offsets[k]));
+  }
+  return table;
+}
+
+template <typename T>
+ppc::util::NumericTable<T> ppc::util::ParseNumericFile(const std::string &path, int num_threads) {
+  const MappedFile file(path, MapAdvice::kSequential);
+  return ParseNumericText<T>(file.Text(), num_threads);
+}
+
+template ppc::util::NumericTable<int> ppc::util::ParseNumericText<int>(std::string_view, int);
+template ppc::util::NumericTable<int64_t> ppc::util::ParseNumericText<int64_t>(std::string_view, int);
+template ppc::util::NumericTable<float> ppc::util::ParseNumericText<float>(std::string_view, int);
+template ppc::util::NumericTable<double> ppc::util::ParseNumericText<double>(std::string_view, int);
+template ppc::util::NumericTable<int> ppc::util::ParseNumericFile<int>(const std::string &, int);
+template ppc::util::NumericTable<int64_t> ppc::util::ParseNumericFile<int64_t>(const std::string &, int);
+template ppc::util::NumericTable<float> ppc::util::ParseNumericFile<float>(const std::string &, int);
+template ppc::util::NumericTable<double> ppc::util::ParseNumericFile<double>(const std::string &, int);
@@ -0,0 +1,107 @@
+#include "util/include/shared_memory.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "util/include/collectives.hpp"
+
+namespace {
+
+bool IsFinalized() {
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  return finalized != 0;
+}
+
+}  // namespace
+
+ppc::util::NodeSharedMemory::NodeSharedMemory(std::size_t bytes, int root, MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  // Ordering the root first makes it the leader of its node and process 0 among the leaders
+  const int key = rank == root ? 0 : 1;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &node_comm_);
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm_, &node_rank);
+  MPI_Comm_split(comm, node_rank == 0 ? 0 : MPI_UNDEFINED, key, &leader_comm_);
+
+  void *base = nullptr;
+  MPI_Win_allocate_shared(static_cast<MPI_Aint>(node_rank == 0 ? bytes : 0), 1, MPI_INFO_NULL, node_comm_, &base,
+                          &window_);
+  MPI_Aint size = 0;
+  int disp_unit = 0;
+  MPI_Win_shared_query(window_, 0, &size, &disp_unit, &base);
+  data_ = static_cast<std::byte *>(base);
+  size_ = bytes;
+  // A single passive epoch for the lifetime of the buffer; Synchronize() orders the accesses within it
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+}
+
+ppc::util::NodeSharedMemory::NodeSharedMemory(NodeSharedMemory &&other) noexcept
+    : node_comm_(std::exchange(other.node_comm_, MPI_COMM_NULL)),
+      leader_comm_(std::exchange(other.leader_comm_, MPI_COMM_NULL)),
+      window_(std::exchange(other.window_, MPI_WIN_NULL)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+ppc::util::NodeSharedMemory &ppc::util::NodeSharedMemory::operator=(NodeSharedMemory &&other) noexcept {
+  if (this != &other) {
+    Release();
+    node_comm_ = std::exchange(other.node_comm_, MPI_COMM_NULL);
+    leader_comm_ = std::exchange(other.leader_comm_, MPI_COMM_NULL);
+    window_ = std::exchange(other.window_, MPI_WIN_NULL);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+ppc::util::NodeSharedMemory::~NodeSharedMemory() {
+  Release();
+}
+
+void ppc::util::NodeSharedMemory::Synchronize() const {
+  MPI_Win_sync(window_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(window_);
+}
+
+// Freeing is collective over the node, which every process reaches by destroying its object
+void ppc::util::NodeSharedMemory::Release() {
+  if (window_ != MPI_WIN_NULL && !IsFinalized()) {
+    MPI_Win_unlock_all(window_);
+    MPI_Win_free(&window_);
+    MPI_Comm_free(&node_comm_);
+    if (leader_comm_ != MPI_COMM_NULL) {
+      MPI_Comm_free(&leader_comm_);
+    }
+  }
+  window_ = MPI_WIN_NULL;
+  node_comm_ = MPI_COMM_NULL;
+  leader_comm_ = MPI_COMM_NULL;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+ppc::util::NodeSharedMemory ppc::util::ShareBytesWithNodes(std::span<const std::byte> data, int root,
+                                                           MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  auto bytes = static_cast<uint64_t>(rank == root ? data.size() : 0);
+  MPI_Bcast(&bytes, 1, MPI_UINT64_T, root, comm);
+
+  NodeSharedMemory memory(bytes, root, comm);
+  if (rank == root) {
+    std::ranges::copy(data, memory.Bytes().begin());
+  }
+  if (memory.IsLeader()) {
+    BcastBytes(memory.Bytes(), 0, memory.LeaderComm());
+  }
+  memory.Synchronize();
+  return memory;
+}
@@ -0,0 +1,197 @@
+#include "util/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace {
+
+// Pool and queue of the current thread if it is a worker
+thread_local const ppc::util::ThreadPool *current_pool = nullptr;
+thread_local int current_worker = -1;
+
+// Enough chunks per thread for the threads to even out iterations of uneven cost
+constexpr std::size_t kChunksPerThread = 4;
+
+}  // namespace
+
+ppc::util::ThreadPool &ppc::util::ThreadPool::Global() {
+  static ThreadPool pool;
+  return pool;
+}
+
+ppc::util::ThreadPool::ThreadPool() : workers_(kMaxWorkers) {}
+
+ppc::util::ThreadPool::~ThreadPool() {
+  {
+    const std::scoped_lock lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void ppc::util::ThreadPool::Reserve(int num_workers) {
+  num_workers = std::min(num_workers, kMaxWorkers);
+  const std::scoped_lock lock(threads_mutex_);
+  while (static_cast<int>(threads_.size()) < num_workers) {
+    const int index = static_cast<int>(threads_.size());
+    threads_.emplace_back([this, index] { WorkerLoop(index); });
+    num_workers_.store(index + 1, std::memory_order_release);
+  }
+}
+
+void ppc::util::ThreadPool::Submit(std::function<void()> job) {
+  const int num_workers = NumWorkers();
+  if (num_workers == 0) {
+    job();
+    return;
+  }
+  // Jobs of a worker stay in its own queue; other threads spread theirs over all workers
+  const int index = current_pool == this
+                        ? current_worker
+                        : static_cast<int>(next_worker_.fetch_add(1, std::memory_order_relaxed) %
+                                           static_cast<std::size_t>(num_workers));
+  {
+    // Counted first, so that a worker never takes a job that is not counted yet
+    const std::scoped_lock lock(sleep_mutex_);
+    pending_.fetch_add(1, std::memory_order_relaxed);
+  }
+  {
+    const std::scoped_lock lock(workers_[index].mutex);
+    workers_[index].jobs.push_back(std::move(job));
+  }
+  wake_.notify_one();
+}
+
+bool ppc::util::ThreadPool::RunPendingJob() {
+  std::function<void()> job;
+  if (!TryPop(job)) {
+    return false;
+  }
+  job();
+  return true;
+}
+
+bool ppc::util::ThreadPool::TryPop(std::function<void()> &job) {
+  const int num_workers = NumWorkers();
+  const int own = current_pool == this ? current_worker : -1;
+  if (own >= 0) {
+    Worker &worker = workers_[own];
+    const std::scoped_lock lock(worker.mutex);
+    if (!worker.jobs.empty()) {
+      job = std::move(worker.jobs.back());
+      worker.jobs.pop_back();
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  // Steal the oldest job, starting behind the own queue so that thieves spread over the victims
+  for (int offset = 1; offset <= num_workers; offset++) {
+    const int index = (own + offset + num_workers) % num_workers;
+    if (index == own) {
+      continue;
+    }
+    Worker &victim = workers_[index];
+    const std::scoped_lock lock(victim.mutex);
+    if (!victim.jobs.empty()) {
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ppc::util::ThreadPool::WorkerLoop(int index) {
+  current_pool = this;
+  current_worker = index;
+  std::function<void()> job;
+  while (true) {
+    if (TryPop(job)) {
+      job();
+      job = nullptr;
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stop_ || pending_.load(std::memory_order_relaxed) > 0; });
+    if (stop_ && pending_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+  }
+}
+
+ppc::util::TaskGroup::~TaskGroup() {
+  WaitForJobs();
+}
+
+void ppc::util::TaskGroup::Wait() {
+  WaitForJobs();
+  std::exception_ptr error;
+  {
+    const std::scoped_lock lock(mutex_);
+    error = std::exchange(error_, nullptr);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ppc::util::TaskGroup::Finish(const std::exception_ptr &error) {
+  const std::scoped_lock lock(mutex_);
+  if (error && !error_) {
+    error_ = error;
+  }
+  pending_--;
+  done_.notify_all();
+}
+
+void ppc::util::TaskGroup::WaitForJobs() {
+  std::unique_lock lock(mutex_);
+  while (pending_ > 0) {
+    // Helping with queued jobs, nested ones included, keeps a waiting worker from stalling the pool
+    lock.unlock();
+    const bool helped = pool_.RunPendingJob();
+    lock.lock();
+    if (!helped && pending_ > 0) {
+      done_.wait(lock);
+    }
+  }
+}
+
+std::size_t ppc::util::CountParallelChunks(std::size_t count, int num_threads) {
+  return std::min(count, static_cast<std::size_t>(std::max(num_threads, 1)) * kChunksPerThread);
+}
+
+void ppc::util::RunParallelChunks(std::size_t num_chunks, int num_threads,
+                                  const std::function<void(std::size_t)> &body) {
+  if (num_threads <= 1 || num_chunks <= 1) {
+    for (std::size_t chunk = 0; chunk < num_chunks; chunk++) {
+      body(chunk);
+    }
+    return;
+  }
+  ThreadPool &pool = ThreadPool::Global();
+  pool.Reserve(num_threads - 1);
+
+  std::atomic<std::size_t> next_chunk = 0;
+  const auto drain = [&] {
+    for (std::size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+      body(chunk);
+    }
+  };
+  const std::size_t helpers = std::min(static_cast<std::size_t>(num_threads - 1), num_chunks - 1);
+  TaskGroup group(pool);
+  for (std::size_t helper = 0; helper < helpers; helper++) {
+    group.Run(drain);
+  }
+  drain();
+  group.Wait();
+}
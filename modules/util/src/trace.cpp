@@ -0,0 +1,77 @@
+#include "util/include/trace.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+void ppc::util::Tracer::Clear() {
+  const std::lock_guard<std::mutex> lock(registry_mutex);
+  for (const auto &buffer : registry) {
+    buffer->events.clear();
+  }
+}
+
+std::size_t ppc::util::Tracer::Size() {
+  const std::lock_guard<std::mutex> lock(registry_mutex);
+  std::size_t size = 0;
+  for (const auto &buffer : registry) {
+    size += buffer->events.size();
+  }
+  return size;
+}
+
+std::string ppc::util::Tracer::SerializeEvents(int pid, int64_t offset_ns) {
+  const std::lock_guard<std::mutex> lock(registry_mutex);
+  auto events = nlohmann::json::array();
+  events.push_back({{"name", "process_name"},
+                    {"ph", "M"},
+                    {"pid", pid},
+                    {"tid", 0},
+                    {"args", {{"name", "rank " + std::to_string(pid)}}}});
+  for (const auto &buffer : registry) {
+    if (buffer->events.empty()) {
+      continue;
+    }
+    const auto thread_name = buffer->tid == 0 ? std::string("main") : "thread " + std::to_string(buffer->tid);
+    events.push_back({{"name", "thread_name"},
+                      {"ph", "M"},
+                      {"pid", pid},
+                      {"tid", buffer->tid},
+                      {"args", {{"name", thread_name}}}});
+    for (const auto &event : buffer->events) {
+      // Chrome trace timestamps are in microseconds
+      events.push_back({{"name", event.name},
+                        {"cat", event.category},
+                        {"ph", "X"},
+                        {"pid", pid},
+                        {"tid", buffer->tid},
+                        {"ts", static_cast<double>(event.begin_ns + offset_ns) * 1e-3},
+                        {"dur", static_cast<double>(event.end_ns - event.begin_ns) * 1e-3}});
+    }
+  }
+  return events.dump();
+}
+
+void ppc::util::Tracer::WriteChromeTrace(const std::string &path, const std::vector<std::string> &event_arrays) {
+  auto trace_events = nlohmann::json::array();
+  for (const auto &event_array : event_arrays) {
+    const auto events = nlohmann::json::parse(event_array, nullptr, false);
+    if (events.is_discarded() || !events.is_array()) {
+      throw std::runtime_error("Malformed trace events for " + path);
+    }
+    trace_events.insert(trace_events.end(), events.begin(), events.end());
+  }
+
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  const nlohmann::json trace = {{"traceEvents", trace_events}, {"displayTimeUnit", "ms"}};
+  file << trace.dump() << '\n';
+}
@@ -2,9 +2,18 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
+#include <cstdlib>
 #include <filesystem>
 #include <libenvpp/detail/get.hpp>
+#include <sstream>
 #include <string>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
 
 namespace {
 
@@ -52,6 +61,106 @@ double ppc::util::GetPerfMaxTime() {
   return 10.0;
 }
 
+int ppc::util::GetPerfWarmupRuns() {
+  const auto val = env::get<int>("PPC_PERF_WARMUP");
+  if (val.has_value()) {
+    return std::max(val.value(), 0);
+  }
+  return 1;
+}
+
+bool ppc::util::IsPerfAdaptive() {
+  const auto val = env::get<int>("PPC_PERF_ADAPTIVE");
+  return val.has_value() && val.value() != 0;
+}
+
+bool ppc::util::IsPerfHwCountersEnabled() {
+  const auto val = env::get<int>("PPC_PERF_HW_COUNTERS");
+  return val.has_value() && val.value() != 0;
+}
+
+std::string ppc::util::GetPerfResultsFile() {
+  return env::get<std::string>("PPC_PERF_RESULTS_FILE").value_or("");
+}
+
+std::string ppc::util::GetPerfBaselineFile() {
+  return env::get<std::string>("PPC_PERF_BASELINE_FILE").value_or("");
+}
+
+std::string ppc::util::GetTraceFile() {
+  return env::get<std::string>("PPC_TRACE_FILE").value_or("");
+}
+
+bool ppc::util::IsCollectiveCheckEnabled() {
+  const auto val = env::get<int>("PPC_CHECK_COLLECTIVES");
+  return val.has_value() && val.value() != 0;
+}
+
+double ppc::util::GetPerfRegressionMargin() {
+  const auto val = env::get<double>("PPC_PERF_REGRESSION_MARGIN");
+  if (val.has_value()) {
+    return std::max(val.value(), 0.0);
+  }
+  return 0.1;
+}
+
+double ppc::util::GetPerfPeakBandwidth() {
+  const auto val = env::get<double>("PPC_PERF_PEAK_BANDWIDTH_GBS");
+  if (val.has_value()) {
+    return std::max(val.value(), 0.0);
+  }
+  return 0.0;
+}
+
+bool ppc::util::IsPerfCalibrationEnabled() {
+  const auto val = env::get<int>("PPC_PERF_CALIBRATION");
+  return val.has_value() && val.value() != 0;
+}
+
+std::vector<int> ppc::util::GetPerfThreadSweep() {
+  const auto val = env::get<std::string>("PPC_PERF_THREAD_SWEEP");
+  std::vector<int> thread_counts;
+  if (!val.has_value()) {
+    return thread_counts;
+  }
+  std::stringstream list(val.value());
+  std::string item;
+  while (std::getline(list, item, ',')) {
+    int threads = 0;
+    const auto [end, ec] = std::from_chars(item.data(), item.data() + item.size(), threads);
+    if (ec == std::errc() && end == item.data() + item.size() && threads > 0) {
+      thread_counts.push_back(threads);
+    }
+  }
+  return thread_counts;
+}
+
+int ppc::util::GetMaxNumThreads() {
+  const auto thread_sweep = GetPerfThreadSweep();
+  if (thread_sweep.empty()) {
+    return GetNumThreads();
+  }
+  return std::max(GetNumThreads(), std::ranges::max(thread_sweep));
+}
+
+bool ppc::util::IsPerfSizeSweepEnabled() {
+  const auto val = env::get<int>("PPC_PERF_SIZE_SWEEP");
+  return val.has_value() && val.value() != 0;
+}
+
+std::string ppc::util::GetHostName() {
+#ifdef _WIN32
+  const char *name = std::getenv("COMPUTERNAME");  // NOLINT(concurrency-mt-unsafe)
+  return name != nullptr ? name : "unknown";
+#else
+  std::array<char, 256> name{};
+  if (gethostname(name.data(), name.size() - 1) != 0) {
+    return "unknown";
+  }
+  return name.data();
+#endif
+}
+
 // List of environment variables that signal the application is running under
 // an MPI launcher. The array size must match the number of entries to avoid
 // looking up empty environment variable names.
@@ -0,0 +1,529 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <libenvpp/detail/environment.hpp>
+#include <libenvpp/detail/get.hpp>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "util/include/collectives.hpp"
+#include "util/include/matrix.hpp"
+#include "util/include/mpi_types.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/shared_memory.hpp"
+#include "util/include/util.hpp"
+
+// The tests below run on any number of processes, e.g. under mpirun with --gtest_filter=*Mpi*. They start MPI
+// themselves if no runner did, and are left out of valgrind runs because the MPI library holds on to its memory.
+// MPI keeps running for the tests of the other suites, so those that expect a single process have to skip when
+// ppc::util::GetMPISize() is larger than one. With --gtest_shuffle all processes need the same --gtest_random_seed.
+
+namespace {
+
+class MpiTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    LaunchedByMpirun();
+    int is_initialized = 0;
+    MPI_Initialized(&is_initialized);
+    if (is_initialized != 0) {
+      return;
+    }
+    MPI_Init(nullptr, nullptr);
+    // MPI cannot be started again once finalized, so it runs until the process exits
+    std::atexit([] {
+      int is_finalized = 0;
+      MPI_Finalized(&is_finalized);
+      if (is_finalized == 0) {
+        MPI_Finalize();
+      }
+    });
+  }
+
+  // Whether mpirun started the process; MPI sets the same variables for a process that starts it on its own
+  static bool LaunchedByMpirun() {
+    static const bool kLaunchedByMpirun = ppc::util::IsUnderMpirun();
+    return kLaunchedByMpirun;
+  }
+
+  static int Rank() {
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return rank;
+  }
+
+  static int Size() {
+    int size = 0;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return size;
+  }
+};
+
+// Elements of three bytes, so that counts in bytes and in elements differ
+constexpr std::size_t kElemSize = 3;
+
+// Blocks of different sizes, and empty ones on odd ranks
+ppc::util::BlockPartition UnevenPartition(int size) {
+  ppc::util::BlockPartition partition;
+  std::size_t total = 0;
+  for (int r = 0; r < size; r++) {
+    const std::size_t count = r % 2 == 1 ? 0 : 7 + static_cast<std::size_t>(r);
+    partition.counts.push_back(count);
+    partition.displs.push_back(total);
+    total += count;
+  }
+  return partition;
+}
+
+std::vector<std::byte> Pattern(std::size_t begin, std::size_t bytes) {
+  std::vector<std::byte> data(bytes);
+  for (std::size_t i = 0; i < bytes; i++) {
+    data[i] = static_cast<std::byte>(((begin + i) * 7 + 1) % 251);
+  }
+  return data;
+}
+
+std::vector<std::byte> BlockPattern(const ppc::util::BlockPartition &partition, int r) {
+  return Pattern(partition.displs[r] * kElemSize, partition.counts[r] * kElemSize);
+}
+
+// Plain MPI calls in bytes; MPI calls in whole elements, since every byte offset exceeds the limit; and point-to-point
+// messages in pieces of four bytes plus a remainder, since even the element counts do
+std::array<ppc::util::TransferLimits, 3> LimitsToTest(const ppc::util::BlockPartition &partition) {
+  std::size_t largest = 1;
+  for (std::size_t r = 0; r < partition.counts.size(); r++) {
+    largest = std::max({largest, partition.counts[r], partition.displs[r]});
+  }
+  return {ppc::util::TransferLimits{}, ppc::util::TransferLimits{.max_count = largest},
+          ppc::util::TransferLimits{.max_count = 2, .piece_bytes = 4}};
+}
+
+TEST_F(MpiTest, ScattervBytesSendsEveryBlockDisabledValgrind) {
+  const auto partition = UnevenPartition(Size());
+  const auto send = Rank() == 0 ? Pattern(0, partition.Total() * kElemSize) : std::vector<std::byte>{};
+  for (const auto &limits : LimitsToTest(partition)) {
+    SCOPED_TRACE(limits.max_count);
+    std::vector<std::byte> recv(partition.counts[Rank()] * kElemSize);
+    ppc::util::ScattervBytes(send, partition, recv, kElemSize, 0, MPI_COMM_WORLD, limits);
+    EXPECT_EQ(recv, BlockPattern(partition, Rank()));
+  }
+}
+
+TEST_F(MpiTest, GathervBytesCollectsEveryBlockOnTheRootDisabledValgrind) {
+  const auto partition = UnevenPartition(Size());
+  const auto send = BlockPattern(partition, Rank());
+  for (const auto &limits : LimitsToTest(partition)) {
+    SCOPED_TRACE(limits.max_count);
+    std::vector<std::byte> recv(Rank() == 0 ? partition.Total() * kElemSize : 0);
+    ppc::util::GathervBytes(send, partition, recv, kElemSize, 0, MPI_COMM_WORLD, limits);
+    if (Rank() == 0) {
+      EXPECT_EQ(recv, Pattern(0, partition.Total() * kElemSize));
+    }
+  }
+}
+
+TEST_F(MpiTest, AllgathervBytesCollectsEveryBlockEverywhereDisabledValgrind) {
+  const auto partition = UnevenPartition(Size());
+  const auto send = BlockPattern(partition, Rank());
+  for (const auto &limits : LimitsToTest(partition)) {
+    SCOPED_TRACE(limits.max_count);
+    std::vector<std::byte> recv(partition.Total() * kElemSize);
+    ppc::util::AllgathervBytes(send, partition, recv, kElemSize, MPI_COMM_WORLD, limits);
+    EXPECT_EQ(recv, Pattern(0, partition.Total() * kElemSize));
+  }
+}
+
+TEST_F(MpiTest, BcastBytesSplitsDataBeyondTheLimitDisabledValgrind) {
+  const auto expected = Pattern(0, 21);
+  for (const auto &limits : {ppc::util::TransferLimits{}, ppc::util::TransferLimits{.max_count = 2, .piece_bytes = 4},
+                             ppc::util::TransferLimits{.max_count = 20, .piece_bytes = 21}}) {
+    SCOPED_TRACE(limits.piece_bytes);
+    auto data = Rank() == 0 ? expected : std::vector<std::byte>(expected.size());
+    ppc::util::BcastBytes(data, 0, MPI_COMM_WORLD, limits);
+    EXPECT_EQ(data, expected);
+  }
+}
+
+TEST_F(MpiTest, CollectivesThrowOnTheProcessWithBadArgumentsDisabledValgrind) {
+  const auto partition = UnevenPartition(Size());
+  const auto send = Pattern(0, partition.Total() * kElemSize);
+  std::vector<std::byte> recv(partition.Total() * kElemSize);
+  // Every process fails its own check, so none of them enters the transfer
+  EXPECT_THROW(ppc::util::AllgathervBytes(send, partition, std::span(recv).first(0), kElemSize, MPI_COMM_WORLD),
+               std::invalid_argument);
+  const auto wrong_partition = ppc::util::GetBlockPartition(10, Size() + 1);
+  EXPECT_THROW(ppc::util::GathervBytes(send, wrong_partition, recv, kElemSize, 0, MPI_COMM_WORLD),
+               std::invalid_argument);
+}
+
+TEST_F(MpiTest, CollectivesThrowOnEveryProcessWithTheCheckEnabledDisabledValgrind) {
+  env::detail::set_scoped_environment_variable check("PPC_CHECK_COLLECTIVES", "1");
+  const auto partition = UnevenPartition(Size());
+  const auto send = Pattern(0, partition.Total() * kElemSize);
+  std::vector<std::byte> recv(partition.Total() * kElemSize);
+  // Only the last process passes a buffer that is too small, yet no process is left waiting in the transfer
+  const auto short_recv = std::span(recv).first(Rank() == Size() - 1 ? 0 : recv.size());
+  const auto last_count = partition.counts[Size() - 1];
+  if (last_count > 0) {
+    EXPECT_THROW(ppc::util::ScattervBytes(send, partition, short_recv, kElemSize, 0, MPI_COMM_WORLD),
+                 std::invalid_argument);
+    EXPECT_THROW(ppc::util::AllgathervBytes(std::span(send).first(partition.counts[Rank()] * kElemSize), partition,
+                                            short_recv, kElemSize, MPI_COMM_WORLD),
+                 std::invalid_argument);
+  }
+  // Here only the root passes too little to send
+  const auto short_send = std::span(send).first(Rank() == 0 ? kElemSize : send.size());
+  EXPECT_THROW(ppc::util::ScattervBytes(short_send, partition, recv, kElemSize, 0, MPI_COMM_WORLD),
+               std::invalid_argument);
+}
+
+TEST_F(MpiTest, PipelinedScattervBytesHandsEveryElementOnceAndInOrderDisabledValgrind) {
+  const auto partition = UnevenPartition(Size());
+  const auto send = Rank() == 0 ? Pattern(0, partition.Total() * kElemSize) : std::vector<std::byte>{};
+  const std::size_t own = partition.counts[Rank()];
+  const std::size_t max_displ = std::ranges::max(partition.displs);
+  for (const std::size_t chunk_elems : {std::size_t{1}, std::size_t{3}, std::size_t{100}}) {
+    // Offsets and counts in bytes, and in whole elements since the chunk in bytes exceeds the limit
+    for (const auto &limits : {ppc::util::TransferLimits{},
+                               ppc::util::TransferLimits{.max_count = std::max(max_displ, chunk_elems)}}) {
+      SCOPED_TRACE(chunk_elems);
+      SCOPED_TRACE(limits.max_count);
+      std::vector<std::byte> received;
+      std::size_t chunks = 0;
+      ppc::util::PipelinedScattervBytes(
+          send, partition, kElemSize, chunk_elems,
+          [&](std::span<const std::byte> chunk) {
+            EXPECT_EQ(chunk.size(), std::min(chunk_elems, own - (received.size() / kElemSize)) * kElemSize);
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            chunks++;
+          },
+          0, MPI_COMM_WORLD, limits);
+      EXPECT_EQ(received, BlockPattern(partition, Rank()));
+      EXPECT_EQ(chunks, (own + chunk_elems - 1) / chunk_elems);
+    }
+  }
+
+  // Only the root passes too little to send, yet with the check enabled no process is left waiting in the transfer
+  env::detail::set_scoped_environment_variable check("PPC_CHECK_COLLECTIVES", "1");
+  const auto short_send = std::span(send).first(Rank() == 0 ? kElemSize : send.size());
+  EXPECT_THROW(ppc::util::PipelinedScattervBytes(short_send, partition, kElemSize, 3,
+                                                 [](std::span<const std::byte>) {}, 0, MPI_COMM_WORLD),
+               std::invalid_argument);
+}
+
+TEST_F(MpiTest, ScatterColumnsSendsWholeColumnsFromEitherLayoutDisabledValgrind) {
+  // Blocks of columns of different widths, and none on odd ranks
+  constexpr std::size_t kRows = 3;
+  const auto columns = UnevenPartition(Size());
+  const std::size_t cols = columns.Total();
+  const auto value = [](std::size_t i, std::size_t j) { return static_cast<int>((i * 1000) + j); };
+
+  std::vector<int> expected;
+  for (std::size_t j = 0; j < columns.counts[Rank()]; j++) {
+    for (std::size_t i = 0; i < kRows; i++) {
+      expected.push_back(value(i, columns.displs[Rank()] + j));
+    }
+  }
+  for (const auto layout : {ppc::util::MatrixLayout::kRowMajor, ppc::util::MatrixLayout::kColMajor}) {
+    SCOPED_TRACE(static_cast<int>(layout));
+    std::vector<int> send;
+    if (Rank() == 0) {
+      send.resize(kRows * cols);
+      for (std::size_t i = 0; i < kRows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+          send[layout == ppc::util::MatrixLayout::kRowMajor ? (i * cols) + j : (j * kRows) + i] = value(i, j);
+        }
+      }
+    }
+    std::vector<int> recv(expected.size());
+    ppc::util::ScatterColumns<int>(send, layout, kRows, cols, columns, recv);
+    EXPECT_EQ(recv, expected);
+  }
+
+  // Only the last process passes a buffer that is too small, and then only the root passes too little to send
+  env::detail::set_scoped_environment_variable check("PPC_CHECK_COLLECTIVES", "1");
+  std::vector<int> recv(expected.size());
+  const auto short_recv = std::span(recv).first(Rank() == Size() - 1 ? 0 : recv.size());
+  const std::vector<int> send(Rank() == 0 ? kRows * cols : 0);
+  if (columns.counts[Size() - 1] > 0) {
+    EXPECT_THROW(ppc::util::ScatterColumns<int>(send, ppc::util::MatrixLayout::kRowMajor, kRows, cols, columns,
+                                                short_recv),
+                 std::invalid_argument);
+  }
+  EXPECT_THROW(ppc::util::ScatterColumns<int>(std::span(send).first(0), ppc::util::MatrixLayout::kRowMajor, kRows,
+                                              cols, columns, recv),
+               std::invalid_argument);
+}
+
+// Counts the communicators and windows freed after Track() was called on them, through attributes whose delete
+// callbacks MPI runs when it frees the object
+class FreeCounter {
+ public:
+  FreeCounter() {
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, CountComm, &comm_key_, &comms_);
+    MPI_Win_create_keyval(MPI_WIN_NULL_COPY_FN, CountWin, &win_key_, &windows_);
+  }
+  FreeCounter(const FreeCounter &) = delete;
+  FreeCounter &operator=(const FreeCounter &) = delete;
+  FreeCounter(FreeCounter &&) = delete;
+  FreeCounter &operator=(FreeCounter &&) = delete;
+  ~FreeCounter() {
+    MPI_Comm_free_keyval(&comm_key_);
+    MPI_Win_free_keyval(&win_key_);
+  }
+
+  void Track(const ppc::util::NodeSharedMemory &memory) const {
+    MPI_Comm_set_attr(memory.NodeComm(), comm_key_, nullptr);
+    if (memory.LeaderComm() != MPI_COMM_NULL) {
+      MPI_Comm_set_attr(memory.LeaderComm(), comm_key_, nullptr);
+    }
+    MPI_Win_set_attr(memory.Window(), win_key_, nullptr);
+  }
+
+  [[nodiscard]] int Comms() const {
+    return comms_;
+  }
+  [[nodiscard]] int Windows() const {
+    return windows_;
+  }
+
+ private:
+  static int CountComm(MPI_Comm /*comm*/, int /*key*/, void * /*value*/, void *counter) {
+    ++*static_cast<int *>(counter);
+    return MPI_SUCCESS;
+  }
+  static int CountWin(MPI_Win /*win*/, int /*key*/, void * /*value*/, void *counter) {
+    ++*static_cast<int *>(counter);
+    return MPI_SUCCESS;
+  }
+
+  int comm_key_ = MPI_KEYVAL_INVALID;
+  int win_key_ = MPI_KEYVAL_INVALID;
+  int comms_ = 0;
+  int windows_ = 0;
+};
+
+TEST_F(MpiTest, NodeSharedMemoryMakesTheRootLeaderZeroDisabledValgrind) {
+  for (const int root : {0, Size() - 1}) {
+    SCOPED_TRACE(root);
+    const ppc::util::NodeSharedMemory memory(16, root, MPI_COMM_WORLD);
+    EXPECT_EQ(memory.Bytes().size(), 16U);
+    int leaders_on_node = memory.IsLeader() ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &leaders_on_node, 1, MPI_INT, MPI_SUM, memory.NodeComm());
+    EXPECT_EQ(leaders_on_node, 1);
+    if (Rank() == root) {
+      ASSERT_TRUE(memory.IsLeader());
+      int leader_rank = -1;
+      MPI_Comm_rank(memory.LeaderComm(), &leader_rank);
+      EXPECT_EQ(leader_rank, 0);
+    }
+  }
+}
+
+TEST_F(MpiTest, NodeSharedMemoryShowsWritesAfterSynchronizeDisabledValgrind) {
+  const ppc::util::NodeSharedMemory memory(64, 0, MPI_COMM_WORLD);
+  // The leader of every node writes, and every process of the node reads
+  if (memory.IsLeader()) {
+    const auto pattern = Pattern(0, 64);
+    std::ranges::copy(pattern, memory.Bytes().begin());
+  }
+  memory.Synchronize();
+  EXPECT_TRUE(std::ranges::equal(memory.Bytes(), Pattern(0, 64)));
+}
+
+TEST_F(MpiTest, ShareWithNodesCopiesTheRootDataEverywhereDisabledValgrind) {
+  const int root = Size() - 1;
+  std::vector<int> expected(1000);
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    expected[i] = static_cast<int>(i * i);
+  }
+  const auto data = Rank() == root ? expected : std::vector<int>{};
+  const auto memory = ppc::util::ShareWithNodes<int>(data, root);
+  EXPECT_TRUE(std::ranges::equal(memory.As<int>(), expected));
+
+  const auto empty = ppc::util::ShareBytesWithNodes({}, root, MPI_COMM_WORLD);
+  EXPECT_TRUE(empty.Bytes().empty());
+}
+
+TEST_F(MpiTest, NodeSharedMemoryFreesItsCommunicatorsAndWindowDisabledValgrind) {
+  const FreeCounter freed;
+  ppc::util::NodeSharedMemory memory(8, 0, MPI_COMM_WORLD);
+  freed.Track(memory);
+  const int comms = memory.IsLeader() ? 2 : 1;
+
+  // Assigning over a buffer releases it
+  memory = ppc::util::NodeSharedMemory(16, 0, MPI_COMM_WORLD);
+  EXPECT_EQ(freed.Comms(), comms);
+  EXPECT_EQ(freed.Windows(), 1);
+  EXPECT_EQ(memory.Bytes().size(), 16U);
+
+  // A moved-from buffer owns nothing, so only the new owner releases it
+  freed.Track(memory);
+  ppc::util::NodeSharedMemory moved(std::move(memory));
+  EXPECT_EQ(memory.Window(), MPI_WIN_NULL);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(memory.NodeComm(), MPI_COMM_NULL);
+  EXPECT_TRUE(memory.Bytes().empty());
+  memory = ppc::util::NodeSharedMemory();
+  EXPECT_EQ(freed.Windows(), 1);
+  moved = ppc::util::NodeSharedMemory();
+  EXPECT_EQ(freed.Comms(), 2 * comms);
+  EXPECT_EQ(freed.Windows(), 2);
+}
+
+struct TypeLayout {
+  int size = 0;
+  MPI_Aint lower_bound = 0;
+  MPI_Aint extent = 0;
+};
+
+TypeLayout LayoutOf(MPI_Datatype type) {
+  TypeLayout layout;
+  MPI_Type_size(type, &layout.size);
+  MPI_Type_get_extent(type, &layout.lower_bound, &layout.extent);
+  return layout;
+}
+
+// Sends one element of `send_type` to the own process and receives it as plain elements of `base`
+template <typename T>
+std::vector<T> SendToSelf(const T *send, MPI_Datatype send_type, int send_count, std::size_t recv_elems) {
+  std::vector<T> recv(recv_elems);
+  const MPI_Datatype base = ppc::util::GetMpiType<T>();
+  MPI_Sendrecv(send, send_count, send_type, 0, 0, recv.data(), static_cast<int>(recv_elems), base, 0, 0,
+               MPI_COMM_SELF, MPI_STATUS_IGNORE);
+  return recv;
+}
+
+TEST_F(MpiTest, GetMpiTypeMapsPredefinedAndDerivedTypesDisabledValgrind) {
+  EXPECT_EQ(ppc::util::GetMpiType<int>(), MPI_INT);
+  EXPECT_EQ(ppc::util::GetMpiType<const double>(), MPI_DOUBLE);
+  EXPECT_EQ(ppc::util::GetMpiType<std::byte>(), MPI_BYTE);
+  EXPECT_EQ(LayoutOf(ppc::util::GetMpiType<unsigned long long>()).size, 8);
+
+  // A char followed by a double: the size leaves out the padding, the extent includes it
+  using Padded = std::pair<char, double>;
+  const auto padded = LayoutOf(ppc::util::GetMpiType<Padded>());
+  EXPECT_EQ(padded.size, 1 + 8);
+  EXPECT_EQ(padded.lower_bound, 0);
+  EXPECT_EQ(padded.extent, static_cast<MPI_Aint>(sizeof(Padded)));
+  EXPECT_EQ(ppc::util::GetMpiType<Padded>(), ppc::util::GetMpiType<Padded>());
+
+  struct Opaque {
+    int a;
+    char b;
+  };
+  const auto opaque = LayoutOf(ppc::util::GetMpiType<Opaque>());
+  EXPECT_EQ(opaque.size, static_cast<int>(sizeof(Opaque)));
+  EXPECT_EQ(opaque.extent, static_cast<MPI_Aint>(sizeof(Opaque)));
+
+  const auto contiguous = ppc::util::MakeContiguousType(5, MPI_INT);
+  EXPECT_EQ(LayoutOf(contiguous.Get()).size, 5 * 4);
+  EXPECT_EQ(LayoutOf(contiguous.Get()).extent, 5 * 4);
+}
+
+TEST_F(MpiTest, MinlocPairsMapToThePredefinedPairTypesDisabledValgrind) {
+  EXPECT_EQ((ppc::util::GetMpiType<std::pair<int, int>>()), MPI_2INT);
+  EXPECT_EQ((ppc::util::GetMpiType<std::pair<double, int>>()), MPI_DOUBLE_INT);
+  EXPECT_EQ((ppc::util::GetMpiType<std::pair<float, int>>()), MPI_FLOAT_INT);
+
+  // The smallest value is on the last process; MPI_MINLOC also carries its rank
+  const std::pair<double, int> local = {static_cast<double>(Size() - Rank()), Rank()};
+  std::pair<double, int> result;
+  MPI_Allreduce(&local, &result, 1, ppc::util::GetMpiType<std::pair<double, int>>(), MPI_MINLOC, MPI_COMM_WORLD);
+  EXPECT_EQ(result.first, 1.0);
+  EXPECT_EQ(result.second, Size() - 1);
+}
+
+TEST_F(MpiTest, ColumnTypeHasTheExtentOfOneElementDisabledValgrind) {
+  // 3 x 4 row-major matrix holding its own index
+  constexpr std::size_t kRows = 3;
+  constexpr std::size_t kCols = 4;
+  std::vector<int> matrix(kRows * kCols);
+  for (std::size_t i = 0; i < matrix.size(); i++) {
+    matrix[i] = static_cast<int>(i);
+  }
+  const auto column = ppc::util::MakeColumnType<int>(kRows, kCols);
+  const auto layout = LayoutOf(column.Get());
+  EXPECT_EQ(layout.size, static_cast<int>(kRows * sizeof(int)));
+  EXPECT_EQ(layout.lower_bound, 0);
+  EXPECT_EQ(layout.extent, static_cast<MPI_Aint>(sizeof(int)));
+
+  // Two columns starting at column 1 arrive one after another
+  const auto columns = SendToSelf(matrix.data() + 1, column.Get(), 2, 2 * kRows);
+  EXPECT_EQ(columns, (std::vector<int>{1, 5, 9, 2, 6, 10}));
+
+  // and go back into place through the same type
+  std::vector<int> restored(matrix.size(), -1);
+  MPI_Sendrecv(columns.data(), static_cast<int>(columns.size()), MPI_INT, 0, 0, restored.data() + 1, 2, column.Get(),
+               0, 0, MPI_COMM_SELF, MPI_STATUS_IGNORE);
+  EXPECT_EQ(restored, (std::vector<int>{-1, 1, 2, -1, -1, 5, 6, -1, -1, 9, 10, -1}));
+}
+
+TEST_F(MpiTest, SubarrayTypeSelectsTheBlockInEitherLayoutDisabledValgrind) {
+  // Rows 1 and 2, columns 2 to 4 of a 4 x 5 matrix holding its row-major index
+  constexpr std::size_t kRows = 4;
+  constexpr std::size_t kCols = 5;
+  const ppc::util::Block2D block{.rows = {.begin = 1, .end = 3}, .cols = {.begin = 2, .end = 5}};
+  std::vector<double> row_major(kRows * kCols);
+  std::vector<double> col_major(kRows * kCols);
+  for (std::size_t i = 0; i < kRows; i++) {
+    for (std::size_t j = 0; j < kCols; j++) {
+      row_major[(i * kCols) + j] = static_cast<double>((i * kCols) + j);
+      col_major[(j * kRows) + i] = static_cast<double>((i * kCols) + j);
+    }
+  }
+
+  const auto from_rows = ppc::util::MakeSubarrayType<double>(kRows, kCols, block, ppc::util::MatrixLayout::kRowMajor);
+  const auto layout = LayoutOf(from_rows.Get());
+  EXPECT_EQ(layout.size, static_cast<int>(6 * sizeof(double)));
+  EXPECT_EQ(layout.extent, static_cast<MPI_Aint>(kRows * kCols * sizeof(double)));
+  EXPECT_EQ(SendToSelf(row_major.data(), from_rows.Get(), 1, 6), (std::vector<double>{7, 8, 9, 12, 13, 14}));
+
+  // A column-major block is sent column by column
+  const auto from_cols =
+      ppc::util::MakeSubarrayType<double>(kRows, kCols, block, ppc::util::MatrixLayout::kColMajor);
+  EXPECT_EQ(SendToSelf(col_major.data(), from_cols.Get(), 1, 6), (std::vector<double>{7, 12, 8, 13, 9, 14}));
+
+  // MPI takes the dimensions as int
+  EXPECT_THROW(ppc::util::MakeSubarrayType<double>(std::size_t{1} << 31, kCols, block), std::invalid_argument);
+}
+
+TEST_F(MpiTest, MpiDatatypeMovesOwnershipDisabledValgrind) {
+  auto type = ppc::util::MakeContiguousType(2, MPI_INT);
+  const MPI_Datatype handle = type.Get();
+  ASSERT_NE(handle, MPI_DATATYPE_NULL);
+  ppc::util::MpiDatatype moved(std::move(type));
+  EXPECT_EQ(moved.Get(), handle);
+  EXPECT_EQ(type.Get(), MPI_DATATYPE_NULL);  // NOLINT(bugprone-use-after-move)
+  type = std::move(moved);
+  EXPECT_EQ(type.Get(), handle);
+}
+
+using MpiDeathTest = MpiTest;
+
+TEST_F(MpiDeathTest, MpiDatatypeOutlivesMpiFinalizeDisabledValgrind) {
+  // The child process inherits the variables that MPI set in this one, so it is told apart by one of its own
+  constexpr std::string_view kChildMarker = "PPC_MPI_DEATH_TEST_CHILD";
+  if (!env::get<int>(kChildMarker).has_value() && LaunchedByMpirun()) {
+    GTEST_SKIP() << "The child process would join the job of mpirun";
+  }
+  env::detail::set_scoped_environment_variable marker(kChildMarker, "1");
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  // Freeing a datatype after MPI_Finalize aborts, so the destructor has to skip it
+  EXPECT_EXIT(
+      {
+        auto type = ppc::util::MakeContiguousType(2, MPI_INT);
+        MPI_Finalize();
+        type = ppc::util::MpiDatatype();
+        std::exit(0);
+      },
+      ::testing::ExitedWithCode(0), "");
+}
+
+}  // namespace
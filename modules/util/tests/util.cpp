@@ -2,11 +2,44 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
 #include <libenvpp/detail/environment.hpp>
 #include <libenvpp/detail/get.hpp>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "omp.h"
+#include "util/include/binary_file.hpp"
+#include "util/include/mapped_file.hpp"
+#include "util/include/matrix.hpp"
+#include "util/include/numeric_text.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/thread_pool.hpp"
+#include "util/include/trace.hpp"
+
+namespace {
+
+// Named after the running test plus a random suffix, so that concurrent or repeated runs never share a file
+std::filesystem::path UniqueTempPath(const std::string &extension) {
+  const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+  return std::filesystem::temp_directory_path() / ("ppc_" + std::string(info->test_suite_name()) + "_" +
+                                                   info->name() + "_" + std::to_string(std::random_device{}()) +
+                                                   extension);
+}
+
+}  // namespace
 
 namespace my::nested {
 struct Type {};
@@ -124,3 +157,295 @@ TEST(GetNumProc, ReadsFromEnvironment) {
   env::detail::set_scoped_environment_variable scoped("PPC_NUM_PROC", "4");
   EXPECT_EQ(ppc::util::GetNumProc(), 4);
 }
+
+TEST(GetPerfWarmupRuns, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<int>("PPC_PERF_WARMUP");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_WARMUP");
+  }
+  EXPECT_EQ(ppc::util::GetPerfWarmupRuns(), 1);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_WARMUP", std::to_string(*old));
+  }
+}
+
+TEST(GetPerfWarmupRuns, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_WARMUP", "3");
+  EXPECT_EQ(ppc::util::GetPerfWarmupRuns(), 3);
+}
+
+TEST(IsPerfAdaptive, ReadsFromEnvironment) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_ADAPTIVE", "1");
+    EXPECT_TRUE(ppc::util::IsPerfAdaptive());
+  }
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_ADAPTIVE", "0");
+  EXPECT_FALSE(ppc::util::IsPerfAdaptive());
+}
+
+TEST(IsPerfHwCountersEnabled, ReadsFromEnvironment) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_HW_COUNTERS", "1");
+    EXPECT_TRUE(ppc::util::IsPerfHwCountersEnabled());
+  }
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_HW_COUNTERS", "0");
+  EXPECT_FALSE(ppc::util::IsPerfHwCountersEnabled());
+}
+
+TEST(GetPerfRegressionMargin, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_REGRESSION_MARGIN", "0.25");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfRegressionMargin(), 0.25);
+}
+
+TEST(GetPerfThreadSweep, ParsesCommaSeparatedCounts) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_THREAD_SWEEP", "1,2,x,0,8");
+    EXPECT_EQ(ppc::util::GetPerfThreadSweep(), (std::vector<int>{1, 2, 8}));
+  }
+  EXPECT_TRUE(ppc::util::GetPerfThreadSweep().empty());
+}
+
+TEST(Tracer, RecordsSpansOnlyWhenEnabled) {
+  ppc::util::Tracer::Clear();
+  { const ppc::util::TraceSpan span("disabled"); }
+  EXPECT_EQ(ppc::util::Tracer::Size(), 0U);
+
+  ppc::util::Tracer::Enable();
+  { const ppc::util::TraceSpan span("main_span"); }
+  std::thread worker([] { const ppc::util::TraceSpan span("worker_span"); });
+  worker.join();
+  ppc::util::Tracer::Disable();
+  EXPECT_EQ(ppc::util::Tracer::Size(), 2U);
+
+  const auto events = nlohmann::json::parse(ppc::util::Tracer::SerializeEvents(3, 1000));
+  int main_tid = -1;
+  int worker_tid = -1;
+  for (const auto &event : events) {
+    EXPECT_EQ(event["pid"], 3);
+    if (event["ph"] == "X" && event["name"] == "main_span") {
+      main_tid = event["tid"];
+      EXPECT_GE(event["dur"].get<double>(), 0.0);
+    } else if (event["ph"] == "X" && event["name"] == "worker_span") {
+      worker_tid = event["tid"];
+    }
+  }
+  EXPECT_GE(main_tid, 0);
+  EXPECT_GE(worker_tid, 0);
+  EXPECT_NE(main_tid, worker_tid);
+  ppc::util::Tracer::Clear();
+}
+
+TEST(Tracer, WritesMergedChromeTrace) {
+  const auto path = UniqueTempPath(".json");
+  ppc::util::Tracer::WriteChromeTrace(path.string(), {R"([{"name":"a","ph":"X","pid":0,"tid":0,"ts":1,"dur":1}])",
+                                                      R"([{"name":"b","ph":"X","pid":1,"tid":0,"ts":2,"dur":1}])"});
+  std::ifstream file(path);
+  const auto trace = nlohmann::json::parse(file);
+  EXPECT_EQ(trace["traceEvents"].size(), 2U);
+  EXPECT_EQ(trace["traceEvents"][1]["pid"], 1);
+  file.close();
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(ppc::util::Tracer::WriteChromeTrace(path.string(), {"not json"}), std::runtime_error);
+}
+
+TEST(GetBlockRange, CoversAllItemsWithBalancedBlocks) {
+  std::size_t next = 0;
+  for (int rank = 0; rank < 4; rank++) {
+    const auto range = ppc::util::GetBlockRange(10, rank, 4);
+    EXPECT_EQ(range.begin, next);
+    EXPECT_EQ(range.Size(), rank < 2 ? 3U : 2U);
+    next = range.end;
+  }
+  EXPECT_EQ(next, 10U);
+  EXPECT_EQ(ppc::util::GetBlockRange(2, 3, 4).Size(), 0U);
+}
+
+TEST(ReadBinaryFile, ReadsWholeFileAndRowBlocks) {
+  const auto path = UniqueTempPath(".bin");
+  const std::array<std::int32_t, 2> dims = {3, 2};
+  const std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(dims.data()), sizeof(dims));
+    file.write(reinterpret_cast<const char *>(values.data()),
+               static_cast<std::streamsize>(values.size() * sizeof(double)));
+  }
+
+  const auto all = ppc::util::ReadBinaryFile<double>(path.string(), ppc::util::BinaryHeaderType::kInt32, 2);
+  EXPECT_EQ(all.header.dims, (std::vector<std::size_t>{3, 2}));
+  EXPECT_EQ(all.data, values);
+
+  const auto block =
+      ppc::util::ReadBinaryRowBlock<double>(path.string(), ppc::util::BinaryHeaderType::kInt32, 2, 1, 2);
+  EXPECT_EQ(block.rows.begin, 2U);
+  EXPECT_EQ(block.data, (std::vector<double>{5.0, 6.0}));
+
+  EXPECT_THROW(ppc::util::ReadBinaryFile<double>(path.string() + ".missing", ppc::util::BinaryHeaderType::kInt32, 2),
+               std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFile, ViewsTextAndTypedElements) {
+  const auto path = UniqueTempPath(".bin");
+  const std::uint64_t count = 3;
+  const std::vector<double> values = {0.5, 1.5, 2.5};
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char *>(values.data()),
+               static_cast<std::streamsize>(values.size() * sizeof(double)));
+  }
+
+  const ppc::util::MappedFile file(path.string());
+  EXPECT_EQ(file.Size(), sizeof(count) + (values.size() * sizeof(double)));
+  EXPECT_EQ(file.Text().size(), file.Size());
+
+  const auto header = ppc::util::ReadBinaryFileHeader(path.string(), ppc::util::BinaryHeaderType::kUInt64, 1);
+  const ppc::util::MappedArray<double> array(path.string(), header, ppc::util::MapAdvice::kRandom);
+  EXPECT_EQ(std::vector<double>(array.begin(), array.end()), values);
+  EXPECT_EQ(ppc::util::MappedArray<double>(path.string(), sizeof(count)).Size(), values.size());
+
+  EXPECT_THROW(ppc::util::MappedArray<double>(path.string(), 4), std::runtime_error);
+  EXPECT_THROW(ppc::util::MappedFile(path.string() + ".missing"), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(ParseNumericText, ParsesRowsWithMixedSeparators) {
+  const auto table = ppc::util::ParseNumericText<double>("1.5 -2\t+3e2\r\n\n4,5;6\n7");
+  EXPECT_EQ(table.Rows(), 3U);
+  EXPECT_EQ(table.Cols(), 0U);
+  EXPECT_EQ(table.values, (std::vector<double>{1.5, -2.0, 300.0, 4.0, 5.0, 6.0, 7.0}));
+  EXPECT_EQ(table.Row(2).size(), 1U);
+
+  EXPECT_EQ(ppc::util::ParseNumericText<int>("").Rows(), 0U);
+  EXPECT_THROW(ppc::util::ParseNumericText<int>("1 2\n3 x\n"), std::runtime_error);
+  EXPECT_THROW(ppc::util::ParseNumericText<int>("12-3"), std::runtime_error);
+  EXPECT_THROW(ppc::util::ParseNumericText<double>("1.2.3"), std::runtime_error);
+  EXPECT_THROW(ppc::util::ParseNumericText<int>("+-5"), std::runtime_error);
+  EXPECT_THROW(ppc::util::ParseNumericText<int>("1 2x"), std::runtime_error);
+  EXPECT_EQ(ppc::util::ParseNumericText<double>("+.5,-7").values, (std::vector<double>{0.5, -7.0}));
+}
+
+TEST(ParseNumericText, SplitsLargeTextsAtLineBoundaries) {
+  const int rows = 300000;
+  std::string text;
+  for (int row = 0; row < rows; row++) {
+    text += std::to_string(row) + " " + std::to_string(-row) + "\n";
+  }
+
+  const auto serial = ppc::util::ParseNumericText<int64_t>(text, 1);
+  const auto parallel = ppc::util::ParseNumericText<int64_t>(text, 4);
+  EXPECT_EQ(parallel.Rows(), static_cast<std::size_t>(rows));
+  EXPECT_EQ(parallel.Cols(), 2U);
+  EXPECT_EQ(parallel.values, serial.values);
+  EXPECT_EQ(parallel.row_offsets, serial.row_offsets);
+  EXPECT_EQ(parallel.Row(rows - 1)[1], -(rows - 1));
+}
+
+TEST(Matrix, ViewsRowsColumnsAndBlocksInBothLayouts) {
+  const std::vector<std::vector<int>> rows = {{1, 2, 3}, {4, 5, 6}};
+  const auto row_major = ppc::util::Matrix<int>::FromRows(rows);
+  const auto col_major = ppc::util::Matrix<int>::FromRows(rows, ppc::util::MatrixLayout::kColMajor);
+
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(row_major.Data().data()) % 64, 0U);
+  EXPECT_EQ(std::vector<int>(row_major.Data().begin(), row_major.Data().end()), (std::vector<int>{1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(std::vector<int>(col_major.Data().begin(), col_major.Data().end()), (std::vector<int>{1, 4, 2, 5, 3, 6}));
+  EXPECT_EQ(row_major, col_major);
+  EXPECT_EQ(row_major.ToLayout(ppc::util::MatrixLayout::kColMajor).Data().size(), col_major.Data().size());
+
+  for (const auto *matrix : {&row_major, &col_major}) {
+    const auto col = matrix->Col(1);
+    EXPECT_EQ(std::vector<int>(col.begin(), col.end()), (std::vector<int>{2, 5}));
+    EXPECT_EQ(std::ranges::min(matrix->Row(1)), 4);
+
+    const auto block = matrix->Block(0, 1, 2, 2);
+    EXPECT_EQ(block(1, 0), 5);
+    EXPECT_EQ(block.Block(1, 1, 1, 1)(0, 0), 6);
+    EXPECT_THROW((void)matrix->Block(1, 1, 2, 1), std::out_of_range);
+  }
+
+  EXPECT_THROW(ppc::util::Matrix<int>::FromRows({{1, 2}, {3}}), std::invalid_argument);
+  EXPECT_THROW(ppc::util::Matrix<int>(2, 2, std::vector<int>{1, 2, 3}), std::invalid_argument);
+}
+
+TEST(GetBlockPartition, MatchesBlockRangesAndScalesByUnit) {
+  const auto partition = ppc::util::GetBlockPartition(10, 4, 3);
+  EXPECT_EQ(partition.counts, (std::vector<std::size_t>{9, 9, 6, 6}));
+  EXPECT_EQ(partition.displs, (std::vector<std::size_t>{0, 9, 18, 24}));
+  EXPECT_EQ(partition.Total(), 30U);
+  EXPECT_EQ(partition.Range(2).begin, ppc::util::GetBlockRange(10, 2, 4).begin * 3);
+
+  const std::size_t huge = std::size_t{3} << 31;
+  EXPECT_EQ(ppc::util::GetBlockPartition(huge, 2).counts.front(), huge / 2);
+}
+
+TEST(GetBlock2D, SplitsRowsAndColumnsOverASquarishGrid) {
+  EXPECT_EQ(ppc::util::GetProcessGrid(6).rows, 3);
+  EXPECT_EQ(ppc::util::GetProcessGrid(6).cols, 2);
+  EXPECT_EQ(ppc::util::GetProcessGrid(7).cols, 1);
+
+  const auto grid = ppc::util::GetProcessGrid(4);
+  std::size_t covered = 0;
+  for (int rank = 0; rank < 4; rank++) {
+    const auto block = ppc::util::GetBlock2D(5, 3, rank, grid);
+    covered += block.rows.Size() * block.cols.Size();
+  }
+  EXPECT_EQ(covered, 15U);
+  const auto last = ppc::util::GetBlock2D(5, 3, 3, grid);
+  EXPECT_EQ(last.rows.begin, 3U);
+  EXPECT_EQ(last.cols.begin, 2U);
+}
+
+TEST(ThreadPool, RunsParallelLoopsReductionsAndNestedGroups) {
+  env::detail::set_scoped_environment_variable scoped("PPC_NUM_THREADS", "4");
+
+  std::vector<int> hits(1000, 0);
+  ppc::util::ParallelFor(0, hits.size(), [&](std::size_t i) { hits[i]++; });
+  EXPECT_TRUE(std::ranges::all_of(hits, [](int hit) { return hit == 1; }));
+
+  const auto sum = ppc::util::ParallelReduce<uint64_t>(
+      1, 10001, 0,
+      [](ppc::util::BlockRange range, uint64_t acc) {
+        for (std::size_t i = range.begin; i < range.end; i++) {
+          acc += i;
+        }
+        return acc;
+      },
+      [](uint64_t lhs, uint64_t rhs) { return lhs + rhs; });
+  EXPECT_EQ(sum, 50005000U);
+
+  // Later loops reuse the workers started by the first one and never run on more threads than requested
+  const int workers = ppc::util::ThreadPool::Global().NumWorkers();
+  std::mutex ids_mutex;
+  std::set<std::thread::id> ids;
+  for (int repeat = 0; repeat < 5; repeat++) {
+    ppc::util::ParallelFor(0, 1000, [&](std::size_t) {
+      const std::scoped_lock lock(ids_mutex);
+      ids.insert(std::this_thread::get_id());
+    });
+    EXPECT_EQ(ppc::util::ThreadPool::Global().NumWorkers(), workers);
+  }
+  EXPECT_LE(ids.size(), static_cast<std::size_t>(ppc::util::GetNumThreads()));
+
+  std::array<std::vector<int>, 8> nested;
+  ppc::util::TaskGroup group;
+  for (auto &values : nested) {
+    values.assign(100, 0);
+    group.Run([&values] { ppc::util::ParallelFor(0, values.size(), [&](std::size_t i) { values[i] = 1; }); });
+  }
+  group.Wait();
+  for (const auto &values : nested) {
+    EXPECT_EQ(std::ranges::count(values, 1), 100);
+  }
+}
+
+TEST(ThreadPool, RethrowsTheFirstExceptionOfAGroup) {
+  env::detail::set_scoped_environment_variable scoped("PPC_NUM_THREADS", "3");
+  ppc::util::ThreadPool::Global().Reserve(2);
+  ppc::util::TaskGroup group;
+  group.Run([] { throw std::runtime_error("job failed"); });
+  group.Run([] {});
+  EXPECT_THROW(group.Wait(), std::runtime_error);
+  EXPECT_NO_THROW(group.Wait());
+}
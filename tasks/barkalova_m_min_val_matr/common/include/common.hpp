@@ -1,16 +1,24 @@
 #pragma once
 
 // #include <string>
+#include <cstddef>
 #include <tuple>
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace barkalova_m_min_val_matr {
 
-using InType = std::vector<std::vector<int>>;
+using InType = ppc::util::Matrix<int>;
 using OutType = std::vector<int>;
 using TestType = std::tuple<std::vector<std::vector<int>>, std::vector<int>>;
 using BaseTask = ppc::task::Task<InType, OutType>;
 
+/// @brief Work of one column minimum search: every matrix element is read once and one value per column is written.
+inline ppc::task::WorkUnits CountWorkUnits(const InType &in) {
+  const std::size_t elements = in.Rows() * in.Cols();
+  return {.bytes_read = elements * sizeof(int), .bytes_written = in.Cols() * sizeof(int), .operations = elements};
+}
+
 }  // namespace barkalova_m_min_val_matr
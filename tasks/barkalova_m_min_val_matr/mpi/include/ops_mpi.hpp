@@ -10,7 +10,8 @@ class BarkalovaMMinValMatrMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BarkalovaMMinValMatrMPI(const InType &in);
+  explicit BarkalovaMMinValMatrMPI(InType in);
+  ppc::task::WorkUnits GetWorkUnits() override;
 
  private:
   bool ValidationImpl() override;
@@ -10,7 +10,8 @@ class BarkalovaMMinValMatrSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit BarkalovaMMinValMatrSEQ(const InType &in);
+  explicit BarkalovaMMinValMatrSEQ(InType in);
+  ppc::task::WorkUnits GetWorkUnits() override;
 
  private:
   bool ValidationImpl() override;
@@ -3,59 +3,56 @@
 #include <algorithm>
 #include <climits>
 #include <cstddef>
-#include <vector>
+#include <utility>
 
 #include "barkalova_m_min_val_matr/common/include/common.hpp"
+#include "util/include/matrix.hpp"
 
 namespace barkalova_m_min_val_matr {
 
-BarkalovaMMinValMatrSEQ::BarkalovaMMinValMatrSEQ(const InType &in) {
+BarkalovaMMinValMatrSEQ::BarkalovaMMinValMatrSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput().resize(in.size());
-  for (size_t i = 0; i < in.size(); ++i) {
-    GetInput()[i] = in[i];
-  }
+  GetInput() = std::move(in);
   GetOutput().clear();
 }
 
 bool BarkalovaMMinValMatrSEQ::ValidationImpl() {
-  const auto &matrix = GetInput();
-  if (matrix.empty()) {
-    return true;
-  }
-  size_t stolb = matrix[0].size();
-  // все строки должны иметь одинак разм
-  return std::ranges::all_of(matrix, [stolb](const auto &row) { return row.size() == stolb; });
+  return true;
 }
 
 bool BarkalovaMMinValMatrSEQ::PreProcessingImpl() {
-  if (!GetInput().empty()) {
-    size_t stolb = GetInput()[0].size();
-    GetOutput().resize(stolb, INT_MAX);
-  } else {
-    GetOutput().clear();
-  }
+  GetOutput().assign(GetInput().Empty() ? 0 : GetInput().Cols(), INT_MAX);
   return true;
 }
 
 bool BarkalovaMMinValMatrSEQ::RunImpl() {
   const auto &matrix = GetInput();
   auto &res = GetOutput();
-  if (matrix.empty()) {
+  if (matrix.Empty()) {
     return true;
   }
-  for (size_t j = 0; j < res.size(); ++j) {
-    int min_val = INT_MAX;
-    for (const auto &row : matrix) {
-      min_val = std::min(row[j], min_val);
+  // Walk the matrix in storage order so that the inner loop runs over contiguous elements
+  if (matrix.Layout() == ppc::util::MatrixLayout::kColMajor) {
+    for (size_t j = 0; j < res.size(); ++j) {
+      res[j] = std::ranges::min(matrix.Data().subspan(j * matrix.Rows(), matrix.Rows()));
+    }
+  } else {
+    for (size_t i = 0; i < matrix.Rows(); ++i) {
+      const auto row = matrix.Data().subspan(i * matrix.Cols(), matrix.Cols());
+      for (size_t j = 0; j < res.size(); ++j) {
+        res[j] = std::min(row[j], res[j]);
+      }
     }
-    res[j] = min_val;
   }
 
   return true;
 }
 
 bool BarkalovaMMinValMatrSEQ::PostProcessingImpl() {
-  return GetInput().empty() || !GetOutput().empty();
+  return GetInput().Empty() || !GetOutput().empty();
+}
+
+ppc::task::WorkUnits BarkalovaMMinValMatrSEQ::GetWorkUnits() {
+  return CountWorkUnits(GetInput());
 }
 }  // namespace barkalova_m_min_val_matr
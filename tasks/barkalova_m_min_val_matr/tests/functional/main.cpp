@@ -12,6 +12,7 @@
 #include "barkalova_m_min_val_matr/mpi/include/ops_mpi.hpp"
 #include "barkalova_m_min_val_matr/seq/include/ops_seq.hpp"
 #include "util/include/func_test_util.hpp"
+#include "util/include/matrix.hpp"
 #include "util/include/util.hpp"
 
 namespace barkalova_m_min_val_matr {
@@ -29,7 +30,7 @@ class BarkalovaMMinValMatrFuncTests : public ppc::util::BaseRunFuncTests<InType,
  protected:
   void SetUp() override {
     test_params_ = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
-    input_matrix_ = std::get<0>(test_params_);
+    input_matrix_ = InType::FromRows(std::get<0>(test_params_));
     expected_output_ = std::get<1>(test_params_);
   }
 
@@ -8,6 +8,7 @@
 #include "barkalova_m_min_val_matr/common/include/common.hpp"
 #include "barkalova_m_min_val_matr/mpi/include/ops_mpi.hpp"
 #include "barkalova_m_min_val_matr/seq/include/ops_seq.hpp"
+#include "util/include/matrix.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace barkalova_m_min_val_matr {
@@ -19,15 +20,12 @@ class BarkalovaMMinValMatrPerfTest : public ppc::util::BaseRunPerfTests<InType,
     const size_t rows = 5000;
     const size_t stolb = 5000;
 
-    std::vector<std::vector<int>> matrix(rows, std::vector<int>(stolb));
-
+    input_data_ = InType(rows, stolb);
     for (size_t i = 0; i < rows; ++i) {
       for (size_t j = 0; j < stolb; ++j) {
-        matrix[i][j] = static_cast<int>(i + j + 1);
+        input_data_(i, j) = static_cast<int>(i + j + 1);
       }
     }
-
-    input_data_ = matrix;
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -37,14 +35,14 @@ class BarkalovaMMinValMatrPerfTest : public ppc::util::BaseRunPerfTests<InType,
       return false;
     }
 
-    if (output_data.size() != matrix[0].size()) {
+    if (output_data.size() != matrix.Cols()) {
       return false;
     }
 
-    std::vector<int> correct_result(matrix[0].size(), INT_MAX);
-    for (const auto &row : matrix) {
-      for (size_t j = 0; j < matrix[0].size(); ++j) {
-        correct_result[j] = std::min(row[j], correct_result[j]);
+    std::vector<int> correct_result(matrix.Cols(), INT_MAX);
+    for (size_t j = 0; j < matrix.Cols(); ++j) {
+      for (int value : matrix.Col(j)) {
+        correct_result[j] = std::min(value, correct_result[j]);
       }
     }
     return output_data == correct_result;
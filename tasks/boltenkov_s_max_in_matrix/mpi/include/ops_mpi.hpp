@@ -10,7 +10,10 @@ class BoltenkovSMaxInMatrixkMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BoltenkovSMaxInMatrixkMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kDistributed;
+  }
+  explicit BoltenkovSMaxInMatrixkMPI(InType in);
 
  private:
   bool ValidationImpl() override;
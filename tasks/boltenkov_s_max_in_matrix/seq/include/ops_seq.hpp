@@ -10,7 +10,7 @@ class BoltenkovSMaxInMatrixkSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit BoltenkovSMaxInMatrixkSEQ(const InType &in);
+  explicit BoltenkovSMaxInMatrixkSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -2,15 +2,16 @@
 
 #include <cmath>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "boltenkov_s_max_in_matrix/common/include/common.hpp"
 
 namespace boltenkov_s_max_in_matrix {
 
-BoltenkovSMaxInMatrixkSEQ::BoltenkovSMaxInMatrixkSEQ(const InType &in) {
+BoltenkovSMaxInMatrixkSEQ::BoltenkovSMaxInMatrixkSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = -std::numeric_limits<double>::max();
 }
 
@@ -4,17 +4,16 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
-#include <fstream>
-#include <ios>
-#include <stdexcept>
 #include <string>
 #include <tuple>
-#include <vector>
+#include <utility>
 
 #include "boltenkov_s_max_in_matrix/common/include/common.hpp"
 #include "boltenkov_s_max_in_matrix/mpi/include/ops_mpi.hpp"
 #include "boltenkov_s_max_in_matrix/seq/include/ops_seq.hpp"
+#include "util/include/binary_file.hpp"
 #include "util/include/func_test_util.hpp"
+#include "util/include/mapped_file.hpp"
 #include "util/include/util.hpp"
 
 namespace boltenkov_s_max_in_matrix {
@@ -28,36 +27,31 @@ class BoltenkovSRunFuncTestsProcesses : public ppc::util::BaseRunFuncTests<InTyp
  protected:
   void SetUp() override {
     TestType params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
-    std::string file_name = params + ".bin";
-    std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_boltenkov_s_max_in_matrix, file_name);
-    std::ifstream file_stream(abs_path, std::ios::in | std::ios::binary);
-    if (!file_stream.is_open()) {
-      throw std::runtime_error("Error opening file!\n");
-    }
-    int m = -1;
-    int n = -1;
-    file_stream.read(reinterpret_cast<char *>(&m), sizeof(int));
-    file_stream.read(reinterpret_cast<char *>(&n), sizeof(int));
-    if (m <= 0 || n <= 0) {
-      throw std::runtime_error("invalid input data!\n");
-    }
-    std::get<0>(input_data_) = n;
-    std::vector<double> &v = std::get<1>(input_data_);
-    v.resize(static_cast<std::size_t>(m) * static_cast<std::size_t>(n));
-    file_stream.read(reinterpret_cast<char *>(v.data()), static_cast<std::streamsize>(sizeof(double) * m * n));
-    file_stream.close();
+    abs_path_ = ppc::util::GetAbsoluteTaskPath(PPC_ID_boltenkov_s_max_in_matrix, params + ".bin");
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
-    return std::ranges::all_of(std::get<1>(input_data_), [&](auto elem) { return elem <= output_data; });
+    // The maximum of the whole file, whichever part of it the task got on this rank
+    const ppc::util::MappedArray<double> matrix(
+        abs_path_, ppc::util::ReadBinaryFileHeader(abs_path_, ppc::util::BinaryHeaderType::kInt32, 2));
+    return output_data == std::ranges::max(matrix.Data());
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    return MakeInput(ppc::util::ReadBinaryFile<double>(abs_path_, ppc::util::BinaryHeaderType::kInt32, 2));
+  }
+
+  InType GetTestInputDataOfRank(int rank, int num_ranks) final {
+    return MakeInput(
+        ppc::util::ReadBinaryRowBlock<double>(abs_path_, ppc::util::BinaryHeaderType::kInt32, 2, rank, num_ranks));
   }
 
  private:
-  InType input_data_;
+  static InType MakeInput(ppc::util::BinaryRows<double> rows) {
+    return {static_cast<int>(rows.header.dims[1]), std::move(rows.data)};
+  }
+
+  std::string abs_path_;
 };
 
 namespace {
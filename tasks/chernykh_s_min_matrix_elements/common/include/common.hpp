@@ -1,13 +1,13 @@
 #pragma once
 
 #include <string>
-#include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/matrix.hpp"
 
 namespace chernykh_s_min_matrix_elements {
 
-using InType = std::vector<std::vector<double>>;
+using InType = ppc::util::Matrix<double>;
 using OutType = double;
 using TestType = std::string;
 using BaseTask = ppc::task::Task<InType, OutType>;
@@ -10,7 +10,7 @@ class ChernykhSMinMatrixElementsMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ChernykhSMinMatrixElementsMPI(const InType &in);
+  explicit ChernykhSMinMatrixElementsMPI(InType in);
 
  private:
   bool ValidationImpl() override;
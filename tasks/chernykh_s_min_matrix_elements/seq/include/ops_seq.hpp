@@ -10,7 +10,7 @@ class ChernykhSMinMatrixElementsSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ChernykhSMinMatrixElementsSEQ(const InType &in);
+  explicit ChernykhSMinMatrixElementsSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -2,14 +2,15 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "chernykh_s_min_matrix_elements/common/include/common.hpp"
 
 namespace chernykh_s_min_matrix_elements {
 
-ChernykhSMinMatrixElementsSEQ::ChernykhSMinMatrixElementsSEQ(const InType &in) {
+ChernykhSMinMatrixElementsSEQ::ChernykhSMinMatrixElementsSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = InType(in);
+  GetInput() = std::move(in);
   GetOutput() = std::numeric_limits<double>::max();
 }
 
@@ -24,15 +25,13 @@ bool ChernykhSMinMatrixElementsSEQ::PreProcessingImpl() {
 bool ChernykhSMinMatrixElementsSEQ::RunImpl() {
   const auto &matrix = GetInput();
 
-  if (matrix.empty()) {
+  if (matrix.Empty()) {
     GetOutput() = std::numeric_limits<double>::max();
     return true;
   }
   double minimum = std::numeric_limits<double>::max();
-  for (const auto &row : matrix) {
-    for (double element : row) {
-      minimum = std::min(element, minimum);
-    }
+  for (double element : matrix.Data()) {
+    minimum = std::min(element, minimum);
   }
 
   GetOutput() = minimum;
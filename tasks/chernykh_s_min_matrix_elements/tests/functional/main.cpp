@@ -5,19 +5,17 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
-#include <fstream>
-#include <ios>
 #include <limits>
-#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
-#include <vector>
 
 #include "chernykh_s_min_matrix_elements/common/include/common.hpp"
 #include "chernykh_s_min_matrix_elements/mpi/include/ops_mpi.hpp"
 #include "chernykh_s_min_matrix_elements/seq/include/ops_seq.hpp"
 #include "util/include/func_test_util.hpp"
+#include "util/include/matrix.hpp"
+#include "util/include/numeric_text.hpp"
 #include "util/include/util.hpp"
 
 namespace chernykh_s_min_matrix_elements {
@@ -35,41 +33,16 @@ class ChernykhSRunFuncTestsMinMatrixElements : public ppc::util::BaseRunFuncTest
     std::string in_file_name = params + ".txt";
     std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_chernykh_s_min_matrix_elements, in_file_name);
 
-    std::ifstream in_file(abs_path, std::ios::in);
-    if (!in_file.is_open()) {
-      throw std::runtime_error("Failed to open file : " + abs_path);
-    }
-
-    input_data_.clear();
-    std::string line;
-
-    while (std::getline(in_file, line)) {
-      if (line.empty()) {
-        continue;
-      }
-
-      std::istringstream iss(line);
-      std::vector<double> row;
-      double value = 0.0;
-
-      while (iss >> value) {
-        while (iss >> value) {
-          row.push_back(value);
-        }
-
-        if (!row.empty()) {
-          input_data_.push_back(row);
-        }
-      }
+    const auto table = ppc::util::ParseNumericFile<double>(abs_path);
+    if (table.Rows() > 0 && table.Cols() == 0) {
+      throw std::runtime_error("Matrix rows differ in length: " + abs_path);
     }
+    input_data_ = InType(table.Rows(), table.Cols(), table.values);
   }
   bool CheckTestOutputData(OutType &output_data) final {
-    const auto &mat = input_data_;
     double expected_min = std::numeric_limits<double>::max();
-    for (const auto &row : mat) {
-      for (double v : row) {
-        expected_min = std::min(expected_min, v);
-      }
+    for (double v : input_data_.Data()) {
+      expected_min = std::min(expected_min, v);
     }
     return std::fabs(output_data - expected_min) < 1e-6;
   }
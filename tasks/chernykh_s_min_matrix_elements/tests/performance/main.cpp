@@ -1,12 +1,13 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <cstddef>
 #include <random>
-#include <vector>
 
 #include "chernykh_s_min_matrix_elements/common/include/common.hpp"
 #include "chernykh_s_min_matrix_elements/mpi/include/ops_mpi.hpp"
 #include "chernykh_s_min_matrix_elements/seq/include/ops_seq.hpp"
+#include "util/include/matrix.hpp"
 #include "util/include/perf_test_util.hpp"
 namespace chernykh_s_min_matrix_elements {
 
@@ -14,20 +15,15 @@ class ChernykhSRunFuncTestsMinMatrixElements : public ppc::util::BaseRunPerfTest
  private:
   InType input_data_;
 
-  static InType GenerateMatrix(int n) {
-    InType matrix;
+  static InType GenerateMatrix(std::size_t n) {
+    InType matrix(n, n);
     int seed = 999;
     std::mt19937 generator(seed);
     std::uniform_real_distribution<double> distribution(-500.0, 500.0);
-    for (int i = 0; i < n; i++) {
-      std::vector<double> row;
-      row.reserve(n);
-      for (int j = 0; j < n; j++) {
-        row.push_back(distribution(generator));
-      }
-      matrix.push_back(row);
+    for (double &element : matrix.Data()) {
+      element = distribution(generator);
     }
-    matrix[n / 2][n / 2] = -1000.0;
+    matrix(n / 2, n / 2) = -1000.0;
     return matrix;
   }
 
@@ -3,12 +3,13 @@
 #include <mpi.h>
 
 #include <atomic>
+#include <cstddef>
 #include <numeric>
-#include <thread>
 #include <vector>
 
 #include "example_threads/common/include/common.hpp"
 #include "oneapi/tbb/parallel_for.h"
+#include "util/include/thread_pool.hpp"
 #include "util/include/util.hpp"
 
 namespace nesterov_a_test_task_threads {
@@ -58,12 +59,8 @@ bool NesterovATestTaskALL::RunImpl() {
 
   {
     GetOutput() *= num_threads;
-    std::vector<std::thread> threads(num_threads);
     std::atomic<int> counter(0);
-    for (int i = 0; i < num_threads; i++) {
-      threads[i] = std::thread([&]() { counter++; });
-      threads[i].join();
-    }
+    ppc::util::ParallelFor(0, num_threads, [&](std::size_t /*i*/) { counter++; });
     GetOutput() /= counter;
   }
 
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <tuple>
+#include <vector>
 
 #include "krasnopevtseva_v_monte_carlo_integration/common/include/common.hpp"
 #include "krasnopevtseva_v_monte_carlo_integration/mpi/include/ops_mpi.hpp"
@@ -17,13 +19,16 @@ class KrasnopevtsevaVMCIntegrationPerfTests : public ppc::util::BaseRunPerfTests
   double tolerance_{};
 
   void SetUp() override {
+    input_data_ = MakeInput(50000000);
+  }
+
+  InType MakeInput(int points) {
     double a = 0.0;
     double b = 2.0;
-    int points = 50000000;
     std::uint8_t func = 0;
-    input_data_ = std::make_tuple(a, b, points, func);
     tolerance_ = (b - a) / std::sqrt(points) * 10;
     expected_integral_ = FuncSystem::AnalyticIntegral(func, a, b);
+    return std::make_tuple(a, b, points, func);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -32,6 +37,14 @@ class KrasnopevtsevaVMCIntegrationPerfTests : public ppc::util::BaseRunPerfTests
   InType GetTestInputData() final {
     return input_data_;
   }
+
+  std::vector<std::size_t> GetTestInputSizes() final {
+    return {6250000, 12500000, 25000000, 50000000};
+  }
+
+  InType GetTestInputDataOfSize(std::size_t size) final {
+    return MakeInput(static_cast<int>(size));
+  }
 };
 
 TEST_P(KrasnopevtsevaVMCIntegrationPerfTests, RunPerfModes) {
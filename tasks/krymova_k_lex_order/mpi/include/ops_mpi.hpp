@@ -10,7 +10,10 @@ class KrymovaKLexOrderMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit KrymovaKLexOrderMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit KrymovaKLexOrderMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -4,15 +4,16 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "krymova_k_lex_order/common/include/common.hpp"
 
 namespace krymova_k_lex_order {
 
-KrymovaKLexOrderMPI::KrymovaKLexOrderMPI(const InType &in) {
+KrymovaKLexOrderMPI::KrymovaKLexOrderMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
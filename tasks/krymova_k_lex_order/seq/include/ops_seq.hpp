@@ -10,7 +10,7 @@ class KrymovaKLexSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit KrymovaKLexSEQ(const InType &in);
+  explicit KrymovaKLexSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -2,13 +2,14 @@
 
 #include <cstddef>
 #include <string>
+#include <utility>
 
 #include "krymova_k_lex_order/common/include/common.hpp"
 
 namespace krymova_k_lex_order {
-KrymovaKLexSEQ::KrymovaKLexSEQ(const InType &in) {
+KrymovaKLexSEQ::KrymovaKLexSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -21,9 +21,8 @@ class KrymovaKLexOrderFuncTestsProcesses : public ppc::util::BaseRunFuncTests<In
 
  protected:
   void SetUp() override {
-    TestType test_params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
-    input_data_ = {std::get<0>(test_params), std::get<1>(test_params)};
-    expected_result_ = std::get<2>(test_params);
+    test_params_ = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
+    expected_result_ = std::get<2>(test_params_);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -31,11 +30,11 @@ class KrymovaKLexOrderFuncTestsProcesses : public ppc::util::BaseRunFuncTests<In
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    return {std::get<0>(test_params_), std::get<1>(test_params_)};
   }
 
  private:
-  InType input_data_;
+  TestType test_params_;
   OutType expected_result_ = 0;
 };
 
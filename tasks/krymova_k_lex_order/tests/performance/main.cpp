@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <utility>
 
 #include "krymova_k_lex_order/common/include/common.hpp"
 #include "krymova_k_lex_order/mpi/include/ops_mpi.hpp"
@@ -11,23 +12,18 @@ namespace krymova_k_lex_order {
 
 class KrymovaKLexOrderPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, OutType> {
   const int kStringLength_ = 100000000;
-  InType input_data_;
-
-  void SetUp() override {
-    std::string str1(kStringLength_, 'a');
-    std::string str2(kStringLength_, 'a');
-
-    str2[kStringLength_ - 1] = 'b';
-
-    input_data_ = {str1, str2};
-  }
 
   bool CheckTestOutputData(OutType &output_data) final {
     return output_data == -1;
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    std::string str1(kStringLength_, 'a');
+    std::string str2(kStringLength_, 'a');
+
+    str2[kStringLength_ - 1] = 'b';
+
+    return {std::move(str1), std::move(str2)};
   }
 };
 
@@ -13,7 +13,10 @@ class KulikATheMostDifferentAdjacentMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit KulikATheMostDifferentAdjacentMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit KulikATheMostDifferentAdjacentMPI(InType in);
 
  private:
   bool ValidationImpl() override;
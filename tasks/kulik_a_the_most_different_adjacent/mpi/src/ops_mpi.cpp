@@ -13,15 +13,9 @@
 
 namespace kulik_a_the_most_different_adjacent {
 
-KulikATheMostDifferentAdjacentMPI::KulikATheMostDifferentAdjacentMPI(const InType &in) {
+KulikATheMostDifferentAdjacentMPI::KulikATheMostDifferentAdjacentMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  int proc_rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &proc_rank);
-  if (proc_rank == 0) {
-    GetInput() = in;
-  } else {
-    GetInput() = InType{};
-  }
+  GetInput() = std::move(in);
 }
 
 bool KulikATheMostDifferentAdjacentMPI::ValidationImpl() {
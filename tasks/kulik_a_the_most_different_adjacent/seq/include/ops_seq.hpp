@@ -10,7 +10,7 @@ class KulikATheMostDifferentAdjacentSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit KulikATheMostDifferentAdjacentSEQ(const InType &in);
+  explicit KulikATheMostDifferentAdjacentSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
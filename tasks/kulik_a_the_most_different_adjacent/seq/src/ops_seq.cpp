@@ -3,15 +3,16 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "kulik_a_the_most_different_adjacent/common/include/common.hpp"
 
 namespace kulik_a_the_most_different_adjacent {
 
-KulikATheMostDifferentAdjacentSEQ::KulikATheMostDifferentAdjacentSEQ(const InType &in) {
+KulikATheMostDifferentAdjacentSEQ::KulikATheMostDifferentAdjacentSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool KulikATheMostDifferentAdjacentSEQ::ValidationImpl() {
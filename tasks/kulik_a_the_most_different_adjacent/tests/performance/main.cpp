@@ -2,43 +2,35 @@
 
 #include <cmath>
 #include <cstddef>
-#include <fstream>
-#include <ios>
-#include <stdexcept>
 #include <string>
 
 #include "kulik_a_the_most_different_adjacent/common/include/common.hpp"
 #include "kulik_a_the_most_different_adjacent/mpi/include/ops_mpi.hpp"
 #include "kulik_a_the_most_different_adjacent/seq/include/ops_seq.hpp"
+#include "util/include/binary_file.hpp"
+#include "util/include/mapped_file.hpp"
 #include "util/include/perf_test_util.hpp"
 #include "util/include/util.hpp"
 
 namespace kulik_a_the_most_different_adjacent {
 
 class KulikATheMostDifferentAdjacentPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  InType input_data_;
+  ppc::util::LazyMappedInput<double> input_data_;
 
   void SetUp() override {
     std::string filename = "vector2.bin";
-    std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_kulik_a_the_most_different_adjacent, filename);
-    std::ifstream filestream(abs_path, std::ios::binary | std::ios::in);
-    if (!filestream.is_open()) {
-      throw std::runtime_error("Failed to open file: " + filename);
-    }
-    size_t vector_size = 0;
-    filestream.read(reinterpret_cast<char *>(&vector_size), sizeof(size_t));
-    input_data_.resize(vector_size);
-    filestream.read(reinterpret_cast<char *>(input_data_.data()),
-                    static_cast<std::streamsize>(vector_size * sizeof(double)));
-    filestream.close();
+    input_data_ = ppc::util::LazyMappedInput<double>(
+        ppc::util::GetAbsoluteTaskPath(PPC_ID_kulik_a_the_most_different_adjacent, filename),
+        ppc::util::BinaryHeaderType::kUInt64, 1);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
-    size_t n = input_data_.size();
+    const auto input_data = input_data_.Array().Data();
+    size_t n = input_data.size();
     bool check = true;
-    double mx = std::abs(input_data_[output_data.first] - input_data_[output_data.second]);
+    double mx = std::abs(input_data[output_data.first] - input_data[output_data.second]);
     for (size_t i = 1; i < n; ++i) {
-      if (std::abs(input_data_[i - 1] - input_data_[i]) - mx > 1e-12) {
+      if (std::abs(input_data[i - 1] - input_data[i]) - mx > 1e-12) {
         check = false;
       }
     }
@@ -46,7 +38,8 @@ class KulikATheMostDifferentAdjacentPerfTests : public ppc::util::BaseRunPerfTes
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    const auto &input_data = input_data_.Array();
+    return {input_data.begin(), input_data.end()};
   }
 };
 
@@ -10,7 +10,10 @@ class LopatinAScalarMultMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit LopatinAScalarMultMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit LopatinAScalarMultMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -2,27 +2,18 @@
 
 #include <mpi.h>
 
-#include <cstdint>
-#include <limits>
-#include <stdexcept>
+#include <cstddef>
 #include <utility>
-#include <vector>
 
 #include "lopatin_a_scalar_mult/common/include/common.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/shared_memory.hpp"
 
 namespace lopatin_a_scalar_mult {
 
-LopatinAScalarMultMPI::LopatinAScalarMultMPI(const InType &in) {
+LopatinAScalarMultMPI::LopatinAScalarMultMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  int proc_rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &proc_rank);
-
-  if (proc_rank == 0) {
-    GetInput() = in;
-  } else {
-    GetInput() = InType{};
-  }
-
+  GetInput() = std::move(in);
   GetOutput() = 0.0;
 }
 
@@ -51,44 +42,19 @@ bool LopatinAScalarMultMPI::RunImpl() {
   const auto &input = GetInput();
   OutType &total_res = GetOutput();
 
-  auto n = static_cast<uint64_t>(input.first.size());
-  MPI_Bcast(&n, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
-
-  uint64_t local_n = n / static_cast<uint64_t>(proc_num);
-
-  if (local_n > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
-    throw std::runtime_error("Too large input vector size!");
-  }
-
-  int local_n_int = static_cast<int>(local_n);
-
-  if (local_n_int > 0) {
-    InType local_data = std::make_pair(std::vector<double>(local_n_int), std::vector<double>(local_n_int));
-
-    MPI_Scatter(input.first.data(), local_n_int, MPI_DOUBLE, local_data.first.data(), local_n_int, MPI_DOUBLE, 0,
-                MPI_COMM_WORLD);
-    MPI_Scatter(input.second.data(), local_n_int, MPI_DOUBLE, local_data.second.data(), local_n_int, MPI_DOUBLE, 0,
-                MPI_COMM_WORLD);
+  // Processes of one node read their blocks straight from a single node-wide copy of the vectors
+  const auto shared_first = ppc::util::ShareWithNodes<double>(input.first);
+  const auto shared_second = ppc::util::ShareWithNodes<double>(input.second);
+  const auto first = shared_first.As<double>();
+  const auto second = shared_second.As<double>();
 
-    OutType proc_res{};
-    for (int i = 0; i < local_n_int; ++i) {
-      proc_res += local_data.first[i] * local_data.second[i];
-    }
-
-    MPI_Reduce(&proc_res, &total_res, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-  }
-
-  if (proc_rank == 0) {
-    if (n % proc_num != 0) {
-      uint64_t tail_index = n - (n % static_cast<uint64_t>(proc_num));
-      for (uint64_t i = tail_index; i < n; ++i) {
-        total_res += input.first[i] * input.second[i];
-      }
-    }
+  const auto range = ppc::util::GetBlockRange(first.size(), proc_rank, proc_num);
+  OutType proc_res{};
+  for (std::size_t i = range.begin; i < range.end; ++i) {
+    proc_res += first[i] * second[i];
   }
 
-  MPI_Bcast(&total_res, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Allreduce(&proc_res, &total_res, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
 
   return true;
 }
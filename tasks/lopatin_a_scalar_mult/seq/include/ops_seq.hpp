@@ -10,7 +10,7 @@ class LopatinAScalarMultSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit LopatinAScalarMultSEQ(const InType &in);
+  explicit LopatinAScalarMultSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
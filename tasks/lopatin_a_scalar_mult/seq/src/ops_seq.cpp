@@ -1,15 +1,16 @@
 #include "lopatin_a_scalar_mult/seq/include/ops_seq.hpp"
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "lopatin_a_scalar_mult/common/include/common.hpp"
 
 namespace lopatin_a_scalar_mult {
 
-LopatinAScalarMultSEQ::LopatinAScalarMultSEQ(const InType &in) {
+LopatinAScalarMultSEQ::LopatinAScalarMultSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0.0;
 }
 
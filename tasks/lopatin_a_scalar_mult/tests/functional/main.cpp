@@ -3,11 +3,9 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
-#include <fstream>
-#include <ios>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -15,6 +13,8 @@
 #include "lopatin_a_scalar_mult/mpi/include/ops_mpi.hpp"
 #include "lopatin_a_scalar_mult/seq/include/ops_seq.hpp"
 #include "util/include/func_test_util.hpp"
+#include "util/include/mapped_file.hpp"
+#include "util/include/numeric_text.hpp"
 #include "util/include/util.hpp"
 
 namespace lopatin_a_scalar_mult {
@@ -29,38 +29,17 @@ class LopatinAScalarMultFuncTests : public ppc::util::BaseRunFuncTests<InType, O
   void SetUp() override {
     TestType params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
     std::string filename = params + ".txt";
-    std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_lopatin_a_scalar_mult, filename);
-    std::ifstream infile(abs_path, std::ios::in);
-    if (!infile.is_open()) {
-      throw std::runtime_error("Failed to open file: " + filename);
+    abs_path_ = ppc::util::GetAbsoluteTaskPath(PPC_ID_lopatin_a_scalar_mult, filename);
+    // Vector a, vector b and the expected product, one per line. Every rank needs the product, but only the ranks
+    // that hold the input parse the vectors
+    const ppc::util::MappedFile file(abs_path_);
+    std::string_view text = file.Text();
+    text = text.substr(0, text.find_last_not_of(" \t\r\n") + 1);
+    const auto expected = ppc::util::ParseNumericText<double>(text.substr(text.rfind('\n') + 1));
+    if (expected.Rows() != 1 || expected.Row(0).empty()) {
+      throw std::runtime_error("Invalid test data: " + filename);
     }
-
-    std::string line;
-    int count = 0;
-    for (count = 0; count < 3 && std::getline(infile, line);) {
-      if (line.empty()) {
-        continue;
-      }
-
-      std::istringstream iss(line);
-      double value = NAN;
-
-      if (count == 0) {
-        while (iss >> value) {
-          input_data_.first.push_back(value);
-        }
-      } else if (count == 1) {
-        while (iss >> value) {
-          input_data_.second.push_back(value);
-        }
-      } else {
-        iss >> output_chekup_data_;
-      }
-
-      ++count;
-    }
-
-    infile.close();
+    output_chekup_data_ = expected.Row(0).front();
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -78,11 +57,16 @@ class LopatinAScalarMultFuncTests : public ppc::util::BaseRunFuncTests<InType, O
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    const auto table = ppc::util::ParseNumericFile<double>(abs_path_);
+    if (table.Rows() < 3) {
+      throw std::runtime_error("Invalid test data: " + abs_path_);
+    }
+    return {std::vector<double>(table.Row(0).begin(), table.Row(0).end()),
+            std::vector<double>(table.Row(1).begin(), table.Row(1).end())};
   }
 
  private:
-  InType input_data_;
+  std::string abs_path_;
   OutType output_chekup_data_{};
 };
 
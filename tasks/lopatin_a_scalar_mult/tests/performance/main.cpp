@@ -15,31 +15,20 @@
 namespace lopatin_a_scalar_mult {
 
 class LopatinAScalarMultPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  InType input_data_;
+  std::string abs_path_;
   OutType output_chekup_data_{};
 
+  // Layout: int n, vector a and vector b of n doubles each, then the expected product as a double
   void SetUp() override {
     std::string filename = "test_vectors_perf_n_4194304.bin";
-    std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_lopatin_a_scalar_mult, filename);
-    std::ifstream infile(abs_path, std::ios::binary | std::ios::in);
+    abs_path_ = ppc::util::GetAbsoluteTaskPath(PPC_ID_lopatin_a_scalar_mult, filename);
+    std::ifstream infile(abs_path_, std::ios::binary | std::ios::in);
     if (!infile.is_open()) {
       throw std::runtime_error("Failed to open file: " + filename);
     }
-
-    int vector_size = 0;
-    infile.read(reinterpret_cast<char *>(&vector_size), sizeof(vector_size));
-
-    input_data_.first.resize(vector_size);
-    input_data_.second.resize(vector_size);
-
-    infile.read(reinterpret_cast<char *>(input_data_.first.data()),
-                static_cast<std::streamsize>(vector_size * sizeof(double)));
-    infile.read(reinterpret_cast<char *>(input_data_.second.data()),
-                static_cast<std::streamsize>(vector_size * sizeof(double)));
-
+    // Every rank needs the expected product; only the ranks that hold the input read the vectors
+    infile.seekg(-static_cast<std::streamoff>(sizeof(output_chekup_data_)), std::ios::end);
     infile.read(reinterpret_cast<char *>(&output_chekup_data_), sizeof(output_chekup_data_));
-
-    infile.close();
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -47,7 +36,23 @@ class LopatinAScalarMultPerfTests : public ppc::util::BaseRunPerfTests<InType, O
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    std::ifstream infile(abs_path_, std::ios::binary | std::ios::in);
+    if (!infile.is_open()) {
+      throw std::runtime_error("Failed to open file: " + abs_path_);
+    }
+
+    int vector_size = 0;
+    infile.read(reinterpret_cast<char *>(&vector_size), sizeof(vector_size));
+
+    InType input_data;
+    input_data.first.resize(vector_size);
+    input_data.second.resize(vector_size);
+
+    infile.read(reinterpret_cast<char *>(input_data.first.data()),
+                static_cast<std::streamsize>(vector_size * sizeof(double)));
+    infile.read(reinterpret_cast<char *>(input_data.second.data()),
+                static_cast<std::streamsize>(vector_size * sizeof(double)));
+    return input_data;
   }
 };
 
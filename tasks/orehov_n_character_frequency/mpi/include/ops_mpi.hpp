@@ -10,7 +10,7 @@ class OrehovNCharacterFrequencyMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit OrehovNCharacterFrequencyMPI(const InType &in);
+  explicit OrehovNCharacterFrequencyMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -3,18 +3,21 @@
 #include <mpi.h>
 
 #include <algorithm>
-#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <tuple>
-#include <vector>
+#include <utility>
 
 #include "orehov_n_character_frequency/common/include/common.hpp"
+#include "util/include/collectives.hpp"
+#include "util/include/partition.hpp"
 
 namespace orehov_n_character_frequency {
 
-OrehovNCharacterFrequencyMPI::OrehovNCharacterFrequencyMPI(const InType &in) {
+OrehovNCharacterFrequencyMPI::OrehovNCharacterFrequencyMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -46,56 +49,25 @@ bool OrehovNCharacterFrequencyMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  std::string local_str;
-  std::string symbol;
-  int length = 0;
-  int global_result = 0;
-  int local_result = 0;
+  const std::string &str = std::get<0>(GetInput());
+  char symbol = 0;
+  uint64_t length = 0;
 
   if (rank == 0) {
-    std::string str = std::get<0>(GetInput());
-    symbol = std::get<1>(GetInput());
-    length = static_cast<int>(str.length());
-    MPI_Bcast(symbol.data(), 1, MPI_CHAR, 0, MPI_COMM_WORLD);
-    MPI_Bcast(&length, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-    int part_size = length / size;
-    int remains = length % size;
-
-    std::vector<int> sendcounts(size);
-    std::vector<int> displs(size);
-
-    for (int i = 0; i < size; i++) {
-      sendcounts[i] = part_size + (i < remains ? 1 : 0);
-      displs[i] = (i * part_size) + std::min(i, remains);
-    }
-
-    local_str.resize(sendcounts[0]);
-
-    MPI_Scatterv(str.data(), sendcounts.data(), displs.data(), MPI_CHAR, local_str.data(), sendcounts[0], MPI_CHAR, 0,
-                 MPI_COMM_WORLD);
-  } else {
-    symbol.resize(1);
-    MPI_Bcast(symbol.data(), 1, MPI_CHAR, 0, MPI_COMM_WORLD);
-    MPI_Bcast(&length, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-    int part_size = length / size;
-    int remains = length % size;
-
-    int local_size = part_size + (rank < remains ? 1 : 0);
-    local_str.resize(local_size);
-
-    MPI_Scatterv(nullptr, nullptr, nullptr, MPI_CHAR, local_str.data(), local_size, MPI_CHAR, 0, MPI_COMM_WORLD);
+    symbol = std::get<1>(GetInput())[0];
+    length = str.length();
   }
-
-  for (size_t i = 0; i < local_str.length(); i++) {
-    if (local_str[i] == symbol[0]) {
-      local_result++;
-    }
-  }
-
-  MPI_Allreduce(&local_result, &global_result, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  GetOutput() = global_result;
+  MPI_Bcast(&symbol, 1, MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&length, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+  // Counting in one chunk of the string overlaps with receiving the next
+  const auto partition = ppc::util::GetBlockPartition(length, size);
+  GetOutput() = ppc::util::PipelinedReduce<char, int>(
+      str, partition, 0,
+      [symbol](int count, std::span<const char> chunk) {
+        return count + static_cast<int>(std::ranges::count(chunk, symbol));
+      },
+      MPI_SUM);
 
   return true;
 }
@@ -10,7 +10,7 @@ class OrehovNCharacterFrequencySEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit OrehovNCharacterFrequencySEQ(const InType &in);
+  explicit OrehovNCharacterFrequencySEQ(InType in);
 
  private:
   bool ValidationImpl() override;
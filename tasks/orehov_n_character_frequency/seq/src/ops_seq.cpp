@@ -2,14 +2,15 @@
 
 #include <cstddef>
 #include <string>
+#include <utility>
 
 #include "orehov_n_character_frequency/common/include/common.hpp"
 
 namespace orehov_n_character_frequency {
 
-OrehovNCharacterFrequencySEQ::OrehovNCharacterFrequencySEQ(const InType &in) {
+OrehovNCharacterFrequencySEQ::OrehovNCharacterFrequencySEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -1,16 +1,18 @@
 #include <gtest/gtest.h>
 #include <stb/stb_image.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
-#include <fstream>
 #include <string>
+#include <string_view>
 #include <tuple>
 
 #include "orehov_n_character_frequency/common/include/common.hpp"
 #include "orehov_n_character_frequency/mpi/include/ops_mpi.hpp"
 #include "orehov_n_character_frequency/seq/include/ops_seq.hpp"
 #include "util/include/func_test_util.hpp"
+#include "util/include/mapped_file.hpp"
 #include "util/include/util.hpp"
 
 namespace orehov_n_character_frequency {
@@ -25,19 +27,14 @@ class OrehovNCharacterFrequencyFuncTests : public ppc::util::BaseRunFuncTests<In
   void SetUp() override {
     TestType params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
     std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_orehov_n_character_frequency, params + ".txt");
-    std::ifstream file(abs_path);
-    if (!file.is_open()) {
-      throw "file not open\n";
-    }
-
-    std::string str;
-    std::string symbol;
-    std::getline(file, str);
-    std::getline(file, symbol);
-
-    file.close();
-
-    input_data_ = std::make_tuple(str, symbol);
+    const ppc::util::MappedFile file(abs_path);
+    const std::string_view text = file.Text();
+
+    // The first line is the string, the second one holds the symbol
+    const std::size_t str_end = std::min(text.find('\n'), text.size());
+    const std::string_view symbol_line = text.substr(std::min(str_end + 1, text.size()));
+    input_data_ = std::make_tuple(std::string(text.substr(0, str_end)),
+                                  std::string(symbol_line.substr(0, symbol_line.find('\n'))));
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
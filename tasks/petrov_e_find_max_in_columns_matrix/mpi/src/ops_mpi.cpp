@@ -3,90 +3,80 @@
 #include <mpi.h>
 
 #include <algorithm>
-#include <cfloat>
-#include <cmath>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
-#include <type_traits>
+#include <span>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "petrov_e_find_max_in_columns_matrix/common/include/common.hpp"
+#include "util/include/collectives.hpp"
+#include "util/include/matrix.hpp"
+#include "util/include/partition.hpp"
 
 namespace petrov_e_find_max_in_columns_matrix {
 
-PetrovEFindMaxInColumnsMatrixMPI::PetrovEFindMaxInColumnsMatrixMPI(const InType &in) {
+PetrovEFindMaxInColumnsMatrixMPI::PetrovEFindMaxInColumnsMatrixMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = {};
 }
 
 bool PetrovEFindMaxInColumnsMatrixMPI::ValidationImpl() {
-  return (std::get<0>(GetInput()) * std::get<1>(GetInput()) == static_cast<int>(std::get<2>(GetInput()).size())) &&
-         (GetOutput().empty());
+  int proc_rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &proc_rank);
+
+  // Only the root holds the matrix, so it checks the size and every process learns the result along with the size
+  std::array<int, 3> dims = {std::get<0>(GetInput()), std::get<1>(GetInput()), 0};
+  if (proc_rank == 0) {
+    const auto size = static_cast<std::int64_t>(std::get<2>(GetInput()).size());
+    dims[2] = static_cast<int>(dims[0] >= 0 && dims[1] >= 0 && std::int64_t{dims[0]} * dims[1] == size);
+  }
+  MPI_Bcast(dims.data(), static_cast<int>(dims.size()), MPI_INT, 0, MPI_COMM_WORLD);
+  if (dims[2] == 0) {
+    return false;
+  }
+  rows_ = static_cast<std::size_t>(dims[0]);
+  cols_ = static_cast<std::size_t>(dims[1]);
+  return GetOutput().empty();
 }
 
 bool PetrovEFindMaxInColumnsMatrixMPI::PreProcessingImpl() {
-  return (std::get<0>(GetInput()) * std::get<1>(GetInput()) == static_cast<int>(std::get<2>(GetInput()).size()));
+  return true;
 }
 
 bool PetrovEFindMaxInColumnsMatrixMPI::RunImpl() {
-  if ((std::get<0>(GetInput()) * std::get<1>(GetInput()) != static_cast<int>(std::get<2>(GetInput()).size()))) {
-    return false;
-  }
-
-  auto &n = std::get<0>(GetInput());
-  auto &m = std::get<1>(GetInput());
-  auto &matrix = std::get<2>(GetInput());
-  OutType &res = GetOutput();
-  using MatrixElemType = std::remove_reference_t<decltype(matrix[0])>;
-  MPI_Datatype mpi_matrix_elem_type = petrov_e_find_max_in_columns_matrix::GetMPIDatatype<MatrixElemType>();
-  if (mpi_matrix_elem_type == MPI_DATATYPE_NULL) {
-    return false;
-  }
   int proc_num = 0;
   int proc_rank = 0;
   MPI_Comm_size(MPI_COMM_WORLD, &proc_num);
   MPI_Comm_rank(MPI_COMM_WORLD, &proc_rank);
-  int i = 0;
-  int j = 0;
-  MatrixElemType max = NAN;
-  res.resize(m);
-  int col_num_per_proc = m / proc_num;
-  int col_num_wo_proc = m % proc_num;
-  int flag = 0;
-
-  std::vector<int> start(proc_num);
-  std::vector<int> end(proc_num);
 
-  int proc_start = 0;
-  int proc_end = 0;
-
-  if (proc_rank == 0) {
-    for (i = 0; i < proc_num; i++) {
-      if (i < col_num_wo_proc) {
-        flag = 1;
-      } else {
-        flag = 0;
-      }
-      start[i] = (i * col_num_per_proc) + std::min(i, col_num_wo_proc);
-      end[i] = start[i] + col_num_per_proc + flag;
-    }
+  const std::size_t n = rows_;
+  const std::size_t m = cols_;
+  const auto &matrix = std::get<2>(GetInput());
+  using MatrixElemType = OutType::value_type;
+  OutType &res = GetOutput();
+  res.assign(m, std::numeric_limits<MatrixElemType>::lowest());
+  if (n == 0 || m == 0) {
+    return true;
   }
 
-  MPI_Scatter(start.data(), 1, MPI_INT, &proc_start, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Scatter(end.data(), 1, MPI_INT, &proc_end, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  OutType proc_res(m, std::numeric_limits<MatrixElemType>::lowest());
+  // The matrix is stored column by column, so every process receives whole columns
+  const auto columns = ppc::util::GetBlockPartition(m, proc_num);
+  const std::size_t proc_cols = columns.counts[proc_rank];
+  std::vector<MatrixElemType> proc_matrix(proc_cols * n);
+  ppc::util::ScatterColumns<MatrixElemType>(matrix, ppc::util::MatrixLayout::kColMajor, n, m, columns, proc_matrix);
 
-  for (i = proc_start; std::cmp_less(i, proc_end); i++) {
-    max = matrix[static_cast<int>(i * n)];
-    for (j = 1; j < n; j++) {
-      max = std::max(matrix[(i * n) + j], max);
-    }
-    proc_res[i] = max;
+  OutType proc_res(proc_cols);
+  for (std::size_t i = 0; i < proc_cols; i++) {
+    const auto column = std::span<const MatrixElemType>(proc_matrix).subspan(i * n, n);
+    proc_res[i] = *std::ranges::max_element(column);
   }
 
-  MPI_Allreduce(proc_res.data(), res.data(), m, mpi_matrix_elem_type, MPI_MAX, MPI_COMM_WORLD);
+  ppc::util::Allgatherv<MatrixElemType>(proc_res, columns, res);
 
   return true;
 }
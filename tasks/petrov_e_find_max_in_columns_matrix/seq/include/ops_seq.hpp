@@ -10,7 +10,7 @@ class PetrovEFindMaxInColumnsMatrixSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit PetrovEFindMaxInColumnsMatrixSEQ(const InType &in);
+  explicit PetrovEFindMaxInColumnsMatrixSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -24,7 +24,6 @@ class PetrovERunFuncFindMaxInColumnsMatrix : public ppc::util::BaseRunFuncTests<
  protected:
   void SetUp() override {
     params_ = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
-    input_data_ = std::make_tuple(std::get<0>(params_), std::get<1>(params_), std::get<2>(params_));
     output_vector_ = std::get<3>(params_);
   }
 
@@ -33,12 +32,11 @@ class PetrovERunFuncFindMaxInColumnsMatrix : public ppc::util::BaseRunFuncTests<
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    return std::make_tuple(std::get<0>(params_), std::get<1>(params_), std::get<2>(params_));
   }
 
  private:
   TestType params_;
-  InType input_data_;
   OutType output_vector_;
 };
 
@@ -15,21 +15,50 @@
 namespace petrov_e_find_max_in_columns_matrix {
 
 class PetrovERunPerfFindMaxInColumnsMatrix : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  InType input_data_;
+  std::string abs_path_;
 
   void SetUp() override {
-    std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_petrov_e_find_max_in_columns_matrix, "perf_test.txt");
-    std::ifstream in(abs_path);
+    abs_path_ = ppc::util::GetAbsoluteTaskPath(PPC_ID_petrov_e_find_max_in_columns_matrix, "perf_test.txt");
+  }
+
+  // Ranks other than 0 of the MPI task get no input, so the check reads the groups of the file one by one instead
+  bool CheckTestOutputData(OutType &output_data) final {
+    std::ifstream in(abs_path_);
+    int n = 0;
+    int m = 0;
+    in >> n;
+    in >> m;
+
+    if (std::cmp_not_equal(m, static_cast<int>(output_data.size()))) {
+      return false;
+    }
+
+    std::vector<double> group(n);
+    char tmp = 0;
+    for (int i = 0; i < m; i++) {
+      for (auto &value : group) {
+        in >> value;
+      }
+      in >> tmp;
+      if (output_data[i] != *std::ranges::max_element(group)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  InType GetTestInputData() final {
+    InType input_data;
+    std::ifstream in(abs_path_);
     if (in.is_open()) {
       int n = 0;
       int m = 0;
       in >> n;
       in >> m;
       int limit = n * m;
-      std::get<0>(input_data_) = n;
-      std::get<1>(input_data_) = m;
-      auto &matrix = std::get<2>(input_data_);
-      matrix.clear();
+      std::get<0>(input_data) = n;
+      std::get<1>(input_data) = m;
+      auto &matrix = std::get<2>(input_data);
       matrix.resize(limit);
       int i = 0;
       int j = 0;
@@ -42,32 +71,7 @@ class PetrovERunPerfFindMaxInColumnsMatrix : public ppc::util::BaseRunPerfTests<
       }
       in.close();
     }
-  }
-
-  bool CheckTestOutputData(OutType &output_data) final {
-    int n = std::get<0>(input_data_);
-    int m = std::get<1>(input_data_);
-    auto &matrix = std::get<2>(input_data_);
-    int i = 0;
-
-    if (std::cmp_not_equal(m, static_cast<int>(output_data.size()))) {
-      return false;
-    }
-
-    for (i = 0; i < m; i++) {
-      using DifferenceType = typename OutType::difference_type;
-      auto start = matrix.begin() + static_cast<DifferenceType>(i) * static_cast<DifferenceType>(n);
-      auto end = start + static_cast<DifferenceType>(n);
-      auto element = *std::max_element(start, end);
-      if (output_data[i] != element) {
-        return false;
-      }
-    }
-    return true;
-  }
-
-  InType GetTestInputData() final {
-    return input_data_;
+    return input_data;
   }
 };
 
@@ -10,7 +10,10 @@ class StringDiffTaskMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit StringDiffTaskMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit StringDiffTaskMPI(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "mpi.h"
@@ -12,9 +13,9 @@
 
 namespace polukhin_v_string_diff {
 
-StringDiffTaskMPI::StringDiffTaskMPI(const InType &in) {
+StringDiffTaskMPI::StringDiffTaskMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
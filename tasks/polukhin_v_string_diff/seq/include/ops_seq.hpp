@@ -10,7 +10,7 @@ class StringDiffTaskSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit StringDiffTaskSEQ(const InType &in);
+  explicit StringDiffTaskSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -4,14 +4,15 @@
 #include <cmath>
 #include <cstddef>
 #include <string>
+#include <utility>
 
 #include "polukhin_v_string_diff/common/include/common.hpp"
 
 namespace polukhin_v_string_diff {
 
-StringDiffTaskSEQ::StringDiffTaskSEQ(const InType &in) {
+StringDiffTaskSEQ::StringDiffTaskSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
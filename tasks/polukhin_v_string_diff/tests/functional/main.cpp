@@ -24,12 +24,10 @@ class PolukhinVRunFuncTestsStringDiff : public ppc::util::BaseRunFuncTests<InTyp
 
  protected:
   void SetUp() override {
-    auto params = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
+    params_ = std::get<static_cast<std::size_t>(ppc::util::GTestParamIndex::kTestParams)>(GetParam());
 
-    const std::string &str1 = std::get<0>(params);
-    const std::string &str2 = std::get<1>(params);
-
-    input_data_ = std::make_pair(str1, str2);
+    const std::string &str1 = std::get<0>(params_);
+    const std::string &str2 = std::get<1>(params_);
 
     expected_output_ = 0;
     size_t min_len = std::min(str1.size(), str2.size());
@@ -49,11 +47,11 @@ class PolukhinVRunFuncTestsStringDiff : public ppc::util::BaseRunFuncTests<InTyp
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    return std::make_pair(std::get<0>(params_), std::get<1>(params_));
   }
 
  private:
-  InType input_data_;
+  TestType params_;
   OutType expected_output_{};
 };
 
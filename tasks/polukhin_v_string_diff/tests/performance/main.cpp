@@ -14,15 +14,6 @@ namespace polukhin_v_string_diff {
 class PolukhinVRunPerfTestsStringDiff : public ppc::util::BaseRunPerfTests<InType, OutType> {
  protected:
   void SetUp() override {
-    const size_t size = 100000000;
-    std::string long_str1(size, 'a');
-    std::string long_str2(size, 'a');
-
-    for (size_t i = 0; i < long_str2.size(); i += 10) {
-      long_str2[i] = 'b';
-    }
-
-    input_data_ = std::make_pair(long_str1, long_str2);
     expected_output_ = 10000000;
   }
 
@@ -31,11 +22,18 @@ class PolukhinVRunPerfTestsStringDiff : public ppc::util::BaseRunPerfTests<InTyp
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    const size_t size = 100000000;
+    std::string long_str1(size, 'a');
+    std::string long_str2(size, 'a');
+
+    for (size_t i = 0; i < long_str2.size(); i += 10) {
+      long_str2[i] = 'b';
+    }
+
+    return std::make_pair(std::move(long_str1), std::move(long_str2));
   }
 
  private:
-  InType input_data_;
   OutType expected_output_{};
 };
 
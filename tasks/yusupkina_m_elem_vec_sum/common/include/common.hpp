@@ -14,4 +14,9 @@ using OutType = int64_t;
 using TestType = std::tuple<int, std::string>;
 using BaseTask = ppc::task::Task<InType, OutType>;
 
+/// @brief Work of one sum: every element is read once and a single value is written.
+inline ppc::task::WorkUnits CountWorkUnits(const InType &in) {
+  return {.bytes_read = in.size() * sizeof(int), .bytes_written = sizeof(OutType), .operations = in.size()};
+}
+
 }  // namespace yusupkina_m_elem_vec_sum
@@ -10,7 +10,8 @@ class YusupkinaMElemVecSumMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit YusupkinaMElemVecSumMPI(const InType &in);
+  explicit YusupkinaMElemVecSumMPI(InType in);
+  ppc::task::WorkUnits GetWorkUnits() override;
 
  private:
   bool ValidationImpl() override;
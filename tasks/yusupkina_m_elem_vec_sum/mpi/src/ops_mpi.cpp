@@ -2,15 +2,19 @@
 
 #include <mpi.h>
 
-#include <vector>
+#include <cstdint>
+#include <span>
+#include <utility>
 
+#include "util/include/collectives.hpp"
+#include "util/include/partition.hpp"
 #include "yusupkina_m_elem_vec_sum/common/include/common.hpp"
 
 namespace yusupkina_m_elem_vec_sum {
 
-YusupkinaMElemVecSumMPI::YusupkinaMElemVecSumMPI(const InType &in) {
+YusupkinaMElemVecSumMPI::YusupkinaMElemVecSumMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -29,46 +33,29 @@ bool YusupkinaMElemVecSumMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &count);
 
-  int vec_size = 0;
+  uint64_t vec_size = 0;
 
   if (rank == 0) {
-    vec_size = static_cast<int>(GetInput().size());
+    vec_size = GetInput().size();
   }
-  MPI_Bcast(&vec_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&vec_size, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
 
   if (vec_size == 0) {
     GetOutput() = 0;
     return true;
   }
 
-  int base_size = vec_size / count;
-  int remainder = vec_size % count;
-  int cur_size = base_size + (rank < remainder ? 1 : 0);
-
-  std::vector<int> sendcounts(count);
-  std::vector<int> displs(count);
-  int start_ind = 0;
-  for (int i = 0; i < count; ++i) {
-    sendcounts[i] = base_size + (i < remainder ? 1 : 0);
-    displs[i] = start_ind;
-    start_ind += sendcounts[i];
-  }
-
-  int *sendbuf = nullptr;
-  if (rank == 0) {
-    sendbuf = GetInput().data();
-  }
-  std::vector<int> local_data(cur_size);
-  MPI_Scatterv(sendbuf, sendcounts.data(), displs.data(), MPI_INT, local_data.data(), cur_size, MPI_INT, 0,
-               MPI_COMM_WORLD);
-
-  OutType local_sum = 0LL;
-  for (int i = 0; i < cur_size; ++i) {
-    local_sum += static_cast<OutType>(local_data[i]);
-  }
-  OutType global_sum = 0LL;
-
-  MPI_Allreduce(&local_sum, &global_sum, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  // Each process sums one chunk of its block while the next chunk is still being sent
+  const auto partition = ppc::util::GetBlockPartition(vec_size, count);
+  const OutType global_sum = ppc::util::PipelinedReduce<int, OutType>(
+      GetInput(), partition, OutType{0},
+      [](OutType sum, std::span<const int> chunk) {
+        for (int value : chunk) {
+          sum += static_cast<OutType>(value);
+        }
+        return sum;
+      },
+      MPI_SUM);
   GetOutput() = global_sum;
   return true;
 }
@@ -77,4 +64,8 @@ bool YusupkinaMElemVecSumMPI::PostProcessingImpl() {
   return true;
 }
 
+ppc::task::WorkUnits YusupkinaMElemVecSumMPI::GetWorkUnits() {
+  return CountWorkUnits(GetInput());
+}
+
 }  // namespace yusupkina_m_elem_vec_sum
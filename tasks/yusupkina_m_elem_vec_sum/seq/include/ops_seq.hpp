@@ -10,7 +10,8 @@ class YusupkinaMElemVecSumSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit YusupkinaMElemVecSumSEQ(const InType &in);
+  explicit YusupkinaMElemVecSumSEQ(InType in);
+  ppc::task::WorkUnits GetWorkUnits() override;
 
  private:
   bool ValidationImpl() override;
@@ -1,15 +1,16 @@
 #include "yusupkina_m_elem_vec_sum/seq/include/ops_seq.hpp"
 
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "yusupkina_m_elem_vec_sum/common/include/common.hpp"
 
 namespace yusupkina_m_elem_vec_sum {
 
-YusupkinaMElemVecSumSEQ::YusupkinaMElemVecSumSEQ(const InType &in) {
+YusupkinaMElemVecSumSEQ::YusupkinaMElemVecSumSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = 0;
 }
 
@@ -31,4 +32,8 @@ bool YusupkinaMElemVecSumSEQ::PostProcessingImpl() {
   return true;
 }
 
+ppc::task::WorkUnits YusupkinaMElemVecSumSEQ::GetWorkUnits() {
+  return CountWorkUnits(GetInput());
+}
+
 }  // namespace yusupkina_m_elem_vec_sum
@@ -12,7 +12,10 @@ class ZagryadskovMAllreduceMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ZagryadskovMAllreduceMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit ZagryadskovMAllreduceMPI(InType in);
 
  private:
   OutType temp_vec_;
@@ -20,11 +23,8 @@ class ZagryadskovMAllreduceMPI : public BaseTask {
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
-  static void ApplyOp(void *recvbuf, const void *tempbuf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm);
   template <typename T>
-  static void ApplyOp(void *recvbuf, const void *tempbuf, int count, MPI_Op op, MPI_Comm comm) {
-    T *r = reinterpret_cast<T *>(recvbuf);
-    const T *t = reinterpret_cast<const T *>(tempbuf);
+  static void ApplyOp(T *r, const T *t, int count, MPI_Op op, MPI_Comm comm) {
     for (int i = 0; i < count; i++) {
       if (op == MPI_SUM) {
         r[i] += t[i];
@@ -37,8 +37,9 @@ class ZagryadskovMAllreduceMPI : public BaseTask {
       }
     }
   }
-  static int MyAllreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
-                         MPI_Comm comm);
+  /// @brief Recursive-doubling allreduce of @p count elements; the MPI datatype follows from T.
+  template <typename T>
+  static int MyAllreduce(const T *sendbuf, T *recvbuf, int count, MPI_Op op, MPI_Comm comm);
 };
 
 }  // namespace zagryadskov_m_allreduce
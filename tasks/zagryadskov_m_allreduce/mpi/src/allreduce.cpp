@@ -2,27 +2,21 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <cstddef>
-#include <cstring>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "util/include/mpi_types.hpp"
 #include "zagryadskov_m_allreduce/common/include/common.hpp"
 #include "zagryadskov_m_allreduce/seq/include/allreduce.hpp"
 
 namespace zagryadskov_m_allreduce {
 
-ZagryadskovMAllreduceMPI::ZagryadskovMAllreduceMPI(const InType &in) {
+ZagryadskovMAllreduceMPI::ZagryadskovMAllreduceMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  int world_rank = 0;
-  int err_code = 0;
-  err_code = MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
-  if (err_code != MPI_SUCCESS) {
-    throw std::runtime_error("MPI_Comm_rank failed");
-  }
-  if (world_rank == 0) {
-    GetInput() = in;
-  }
+  GetInput() = std::move(in);
 }
 
 bool ZagryadskovMAllreduceMPI::ValidationImpl() {
@@ -82,32 +76,18 @@ bool ZagryadskovMAllreduceMPI::PreProcessingImpl() {
   return true;
 }
 
-void ZagryadskovMAllreduceMPI::ApplyOp(void *recvbuf, const void *tempbuf, int count, MPI_Datatype type, MPI_Op op,
-                                       MPI_Comm comm) {
-  if (type == MPI_INT) {
-    ApplyOp<int>(recvbuf, tempbuf, count, op, comm);
-  } else if (type == MPI_DOUBLE) {
-    ApplyOp<double>(recvbuf, tempbuf, count, op, comm);
-  } else if (type == MPI_FLOAT) {
-    ApplyOp<float>(recvbuf, tempbuf, count, op, comm);
-  } else {
-    MPI_Abort(comm, 1);
-  }
-}
-
-int ZagryadskovMAllreduceMPI::MyAllreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype,
-                                          MPI_Op op, MPI_Comm comm) {
+template <typename T>
+int ZagryadskovMAllreduceMPI::MyAllreduce(const T *sendbuf, T *recvbuf, int count, MPI_Op op, MPI_Comm comm) {
   int rank = 0;
   int size = 0;
   MPI_Comm_rank(comm, &rank);
   MPI_Comm_size(comm, &size);
 
-  int type_size = 0;
-  MPI_Type_size(datatype, &type_size);
-  std::vector<unsigned char> container_buf(static_cast<size_t>(count) * static_cast<size_t>(type_size));
-  void *tempbuf = reinterpret_cast<void *>(container_buf.data());
+  const MPI_Datatype datatype = ppc::util::GetMpiType<T>();
+  std::vector<T> container_buf(static_cast<size_t>(count));
+  T *tempbuf = container_buf.data();
 
-  memcpy(recvbuf, sendbuf, static_cast<size_t>(count) * static_cast<size_t>(type_size));
+  std::copy(sendbuf, sendbuf + count, recvbuf);
 
   int p2 = 1;
   while (p2 << 1 <= size) {
@@ -126,7 +106,7 @@ int ZagryadskovMAllreduceMPI::MyAllreduce(const void *sendbuf, void *recvbuf, in
   if (rank + p2 < size) {
     int partner = rank + p2;
     MPI_Recv(tempbuf, count, datatype, partner, 0, comm, MPI_STATUS_IGNORE);
-    ApplyOp(recvbuf, tempbuf, count, datatype, op, comm);
+    ApplyOp(recvbuf, tempbuf, count, op, comm);
   }
 
   for (int step = 0; (1 << step) < p2; step++) {
@@ -137,7 +117,7 @@ int ZagryadskovMAllreduceMPI::MyAllreduce(const void *sendbuf, void *recvbuf, in
     MPI_Recv(tempbuf, count, datatype, partner, 0, comm, MPI_STATUS_IGNORE);
     MPI_Wait(&request, MPI_STATUS_IGNORE);
 
-    ApplyOp(recvbuf, tempbuf, count, datatype, op, comm);
+    ApplyOp(recvbuf, tempbuf, count, op, comm);
   }
 
   if (rank + p2 < size) {
@@ -171,8 +151,8 @@ bool ZagryadskovMAllreduceMPI::RunImpl() {
 
   GetOutput().resize(temp_vec_.size());
   MPI_Op op = ZagryadskovMAllreduceSEQ::GetOp(iop);
-  ZagryadskovMAllreduceMPI::MyAllreduce(temp_vec_.data(), GetOutput().data(), static_cast<int>(temp_vec_.size()),
-                                        MPI_INT, op, MPI_COMM_WORLD);
+  ZagryadskovMAllreduceMPI::MyAllreduce(temp_vec_.data(), GetOutput().data(), static_cast<int>(temp_vec_.size()), op,
+                                        MPI_COMM_WORLD);
 
   err_code = MPI_Barrier(MPI_COMM_WORLD);
   if (err_code != MPI_SUCCESS) {
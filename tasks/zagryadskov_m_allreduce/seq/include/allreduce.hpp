@@ -12,7 +12,7 @@ class ZagryadskovMAllreduceSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ZagryadskovMAllreduceSEQ(const InType &in);
+  explicit ZagryadskovMAllreduceSEQ(InType in);
 
  private:
   OutType temp_vec_;
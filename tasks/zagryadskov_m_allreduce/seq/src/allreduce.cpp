@@ -4,12 +4,13 @@
 
 #include <cstddef>
 #include <stdexcept>
+#include <utility>
 
 #include "zagryadskov_m_allreduce/common/include/common.hpp"
 
 namespace zagryadskov_m_allreduce {
 
-ZagryadskovMAllreduceSEQ::ZagryadskovMAllreduceSEQ(const InType &in) {
+ZagryadskovMAllreduceSEQ::ZagryadskovMAllreduceSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   int world_rank = 0;
   int err_code = 0;
@@ -18,7 +19,7 @@ ZagryadskovMAllreduceSEQ::ZagryadskovMAllreduceSEQ(const InType &in) {
     throw std::runtime_error("MPI_Comm_rank failed");
   }
   if (world_rank == 0) {
-    GetInput() = in;
+    GetInput() = std::move(in);
   }
 }
 
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "util/include/perf_test_util.hpp"
+#include "util/include/util.hpp"
 #include "zagryadskov_m_allreduce/common/include/common.hpp"
 #include "zagryadskov_m_allreduce/mpi/include/allreduce.hpp"
 #include "zagryadskov_m_allreduce/seq/include/allreduce.hpp"
@@ -14,35 +15,24 @@
 namespace zagryadskov_m_allreduce {
 
 class ZagryadskovMRunPerfTestAllreduce : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  InType input_data_;
-
   void SetUp() override {
     TestType params = 1;
-    int seed = params;
-    std::mt19937 e(seed);
-    std::uniform_int_distribution<int> gen(-100, 100);
-    int op = 0;
-    int count = 25 + (params * 50'000'000);
-    int processes = 4;
-
-    std::get<1>(input_data_) = count;
-    std::get<2>(input_data_) = op;
-    auto &data_vec = std::get<0>(input_data_);
-    data_vec.resize(static_cast<size_t>(count) * static_cast<size_t>(processes));
-
-    for (int i = 0; i < count * processes; ++i) {
-      data_vec[i] = gen(e);
-    }
+    seed_ = params;
+    op_ = 0;
+    count_ = 25 + (params * 50'000'000);
+    processes_ = 4;
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
     bool res = true;
     OutType example(output_data.size());
 
-    int count = std::get<1>(input_data_);
+    int count = count_;
     std::vector<int> in_data(count);
-    MPI_Op op = ZagryadskovMAllreduceSEQ::GetOp(std::get<2>(input_data_));
-    MPI_Scatter(std::get<0>(input_data_).data(), count, MPI_INT, in_data.data(), count, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Op op = ZagryadskovMAllreduceSEQ::GetOp(op_);
+    // Only the root sends, so the other ranks skip generating the data
+    const std::vector<int> data = ppc::util::GetMPIRank() == 0 ? GenerateData() : std::vector<int>{};
+    MPI_Scatter(data.data(), count, MPI_INT, in_data.data(), count, MPI_INT, 0, MPI_COMM_WORLD);
     MPI_Allreduce(in_data.data(), example.data(), count, MPI_INT, op, MPI_COMM_WORLD);
 
     for (size_t i = 0; i < output_data.size(); ++i) {
@@ -55,8 +45,23 @@ class ZagryadskovMRunPerfTestAllreduce : public ppc::util::BaseRunPerfTests<InTy
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    return {GenerateData(), count_, op_};
   }
+
+  std::vector<int> GenerateData() const {
+    std::mt19937 e(seed_);
+    std::uniform_int_distribution<int> gen(-100, 100);
+    std::vector<int> data_vec(static_cast<size_t>(count_) * static_cast<size_t>(processes_));
+    for (auto &value : data_vec) {
+      value = gen(e);
+    }
+    return data_vec;
+  }
+
+  int seed_ = 0;
+  int op_ = 0;
+  int count_ = 0;
+  int processes_ = 0;
 };
 
 TEST_P(ZagryadskovMRunPerfTestAllreduce, RunPerfModes) {
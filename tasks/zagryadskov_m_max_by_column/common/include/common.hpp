@@ -14,4 +14,10 @@ using OutType = std::vector<double>;
 using TestType = std::string;
 using BaseTask = ppc::task::Task<InType, OutType>;
 
+/// @brief Work of one column maximum search: every matrix element is read once and one value per column is written.
+inline ppc::task::WorkUnits CountWorkUnits(const InType &in) {
+  const auto &[n, mat] = in;
+  return {.bytes_read = mat.size() * sizeof(double), .bytes_written = n * sizeof(double), .operations = mat.size()};
+}
+
 }  // namespace zagryadskov_m_max_by_column
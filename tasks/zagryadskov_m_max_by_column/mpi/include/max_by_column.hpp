@@ -1,10 +1,7 @@
 #pragma once
 
-#include <mpi.h>
-
-#include <vector>
-
 #include "task/include/task.hpp"
+#include "util/include/partition.hpp"
 #include "zagryadskov_m_max_by_column/common/include/common.hpp"
 
 namespace zagryadskov_m_max_by_column {
@@ -14,15 +11,19 @@ class ZagryadskovMMaxByColumnMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ZagryadskovMMaxByColumnMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit ZagryadskovMMaxByColumnMPI(InType in);
+  ppc::task::WorkUnits GetWorkUnits() override;
 
  private:
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
-  static bool SecondPhase(int m, int n, int world_size, int world_rank, std::vector<int> &sendcounts,
-                          std::vector<int> &displs, OutType &res, OutType &local_res, MPI_Datatype datatype);
+  static bool SecondPhase(int world_rank, const ppc::util::BlockPartition &partition, OutType &res,
+                          const OutType &local_res);
 };
 
 }  // namespace zagryadskov_m_max_by_column
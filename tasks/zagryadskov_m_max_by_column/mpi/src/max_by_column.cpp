@@ -4,25 +4,21 @@
 
 #include <cstddef>
 #include <limits>
+#include <span>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
-#include <vector>
 
+#include "util/include/collectives.hpp"
+#include "util/include/matrix.hpp"
+#include "util/include/partition.hpp"
 #include "zagryadskov_m_max_by_column/common/include/common.hpp"
 
 namespace zagryadskov_m_max_by_column {
 
-ZagryadskovMMaxByColumnMPI::ZagryadskovMMaxByColumnMPI(const InType &in) {
+ZagryadskovMMaxByColumnMPI::ZagryadskovMMaxByColumnMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  int world_rank = 0;
-  int err_code = 0;
-  err_code = MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
-  if (err_code != MPI_SUCCESS) {
-    throw std::runtime_error("MPI_Comm_rank failed");
-  }
-  if (world_rank == 0) {
-    GetInput() = in;
-  }
+  GetInput() = std::move(in);
 }
 
 bool ZagryadskovMMaxByColumnMPI::ValidationImpl() {
@@ -49,32 +45,12 @@ bool ZagryadskovMMaxByColumnMPI::PreProcessingImpl() {
   return true;
 }
 
-bool ZagryadskovMMaxByColumnMPI::SecondPhase(int m, int n, int world_size, int world_rank, std::vector<int> &sendcounts,
-                                             std::vector<int> &displs, OutType &res, OutType &local_res,
-                                             MPI_Datatype datatype) {
-  int r = 0;
-  int err_code = 0;
-  for (r = 0; r < world_size; ++r) {
-    sendcounts[r] /= m;
-    if (r > 0) {
-      displs[r] = displs[r - 1] + sendcounts[r - 1];
-    }
-  }
-
-  err_code = MPI_Gatherv(local_res.data(), static_cast<int>(local_res.size()), datatype, res.data(), sendcounts.data(),
-                         displs.data(), datatype, 0, MPI_COMM_WORLD);
-  if (err_code != MPI_SUCCESS) {
-    throw std::runtime_error("MPI_Gatherv failed");
-  }
-  if (world_rank != 0) {
-    res.resize(n);
-  }
-  // sequential version requires not to call MPI funcs
-  err_code = MPI_Bcast(res.data(), static_cast<int>(res.size()), datatype, 0, MPI_COMM_WORLD);
-  if (err_code != MPI_SUCCESS) {
-    throw std::runtime_error("MPI_Bcast failed");
-  }
+bool ZagryadskovMMaxByColumnMPI::SecondPhase(int world_rank, const ppc::util::BlockPartition &partition,
+                                             OutType &res, const OutType &local_res) {
+  res.resize(partition.Total());
+  ppc::util::Allgatherv<OutType::value_type>(local_res, partition, res);
 
+  int err_code = 0;
   bool result = false;
   if (world_rank == 0) {
     result = !res.empty();
@@ -101,22 +77,15 @@ bool ZagryadskovMMaxByColumnMPI::RunImpl() {
     throw std::runtime_error("MPI_Comm_rank failed");
   }
   int n = 0;
-  const void *mat_data = nullptr;
   int m = 0;
+  std::span<const OutType::value_type> mat_data;
   OutType &res = GetOutput();
-  OutType local_res;
-  OutType columns;
-  std::vector<int> sendcounts(world_size);
-  std::vector<int> displs(world_size);
-  if (!displs.empty()) {
-    displs[0] = 0;
-  }
 
   if (world_rank == 0) {
     n = static_cast<int>(std::get<0>(GetInput()));
     const auto &mat = std::get<1>(GetInput());
     m = static_cast<int>(mat.size()) / n;
-    mat_data = reinterpret_cast<const void *>(mat.data());
+    mat_data = mat;
   }
   err_code = MPI_Bcast(&n, 1, MPI_INT, 0, MPI_COMM_WORLD);
   if (err_code != MPI_SUCCESS) {
@@ -127,33 +96,17 @@ bool ZagryadskovMMaxByColumnMPI::RunImpl() {
     throw std::runtime_error("MPI_Bcast failed");
   }
 
-  int columns_count = n / world_size;
-  using T = double;  // datatype cannot be sent to other processes
-  MPI_Datatype datatype = MPI_DOUBLE;
-
+  using T = OutType::value_type;
   int i = 0;
   int j = 0;
-  int r = 0;
   T tmp = std::numeric_limits<T>::lowest();
   bool tmp_flag = false;
 
-  if (world_rank == 0) {
-    res.assign(n, std::numeric_limits<T>::lowest());
-  }
-  for (r = 0; r < world_size; ++r) {
-    sendcounts[r] = (columns_count + static_cast<int>(r < (n % world_size))) * m;
-    if (r > 0) {
-      displs[r] = displs[r - 1] + sendcounts[r - 1];
-    }
-  }
-
-  local_res.assign(static_cast<size_t>(sendcounts[world_rank] / m), std::numeric_limits<T>::lowest());
-  columns.resize(sendcounts[world_rank]);
-  err_code = MPI_Scatterv(mat_data, sendcounts.data(), displs.data(), datatype, columns.data(), sendcounts[world_rank],
-                          datatype, 0, MPI_COMM_WORLD);
-  if (err_code != MPI_SUCCESS) {
-    throw std::runtime_error("MPI_Scatterv failed");
-  }
+  // n columns of m elements each, stored one after another
+  const auto partition = ppc::util::GetBlockPartition(n, world_size);
+  OutType local_res(partition.counts[world_rank], std::numeric_limits<T>::lowest());
+  OutType columns(local_res.size() * m);
+  ppc::util::ScatterColumns<T>(mat_data, ppc::util::MatrixLayout::kColMajor, m, n, partition, columns);
   for (j = 0; std::cmp_less(j, local_res.size()); ++j) {
     for (i = 0; i < m; ++i) {
       tmp = columns[(j * m) + i];
@@ -162,7 +115,7 @@ bool ZagryadskovMMaxByColumnMPI::RunImpl() {
     }
   }
 
-  return SecondPhase(m, n, world_size, world_rank, sendcounts, displs, res, local_res, datatype);
+  return SecondPhase(world_rank, partition, res, local_res);
 }
 
 bool ZagryadskovMMaxByColumnMPI::PostProcessingImpl() {
@@ -177,4 +130,8 @@ bool ZagryadskovMMaxByColumnMPI::PostProcessingImpl() {
   return result;
 }
 
+ppc::task::WorkUnits ZagryadskovMMaxByColumnMPI::GetWorkUnits() {
+  return CountWorkUnits(GetInput());
+}
+
 }  // namespace zagryadskov_m_max_by_column
@@ -10,7 +10,8 @@ class ZagryadskovMMaxByColumnSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ZagryadskovMMaxByColumnSEQ(const InType &in);
+  explicit ZagryadskovMMaxByColumnSEQ(InType in);
+  ppc::task::WorkUnits GetWorkUnits() override;
 
  private:
   bool ValidationImpl() override;
@@ -3,14 +3,15 @@
 #include <cstddef>
 #include <limits>
 #include <type_traits>
+#include <utility>
 
 #include "zagryadskov_m_max_by_column/common/include/common.hpp"
 
 namespace zagryadskov_m_max_by_column {
 
-ZagryadskovMMaxByColumnSEQ::ZagryadskovMMaxByColumnSEQ(const InType &in) {
+ZagryadskovMMaxByColumnSEQ::ZagryadskovMMaxByColumnSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool ZagryadskovMMaxByColumnSEQ::ValidationImpl() {
@@ -56,4 +57,8 @@ bool ZagryadskovMMaxByColumnSEQ::PostProcessingImpl() {
   return !GetOutput().empty();
 }
 
+ppc::task::WorkUnits ZagryadskovMMaxByColumnSEQ::GetWorkUnits() {
+  return CountWorkUnits(GetInput());
+}
+
 }  // namespace zagryadskov_m_max_by_column
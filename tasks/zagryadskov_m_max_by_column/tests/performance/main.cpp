@@ -3,14 +3,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <fstream>
-#include <ios>
-#include <iosfwd>
 #include <limits>
-#include <stdexcept>
 #include <string>
-#include <type_traits>
+#include <vector>
 
+#include "util/include/binary_file.hpp"
+#include "util/include/mapped_file.hpp"
 #include "util/include/perf_test_util.hpp"
 #include "util/include/util.hpp"
 #include "zagryadskov_m_max_by_column/common/include/common.hpp"
@@ -20,42 +18,25 @@
 namespace zagryadskov_m_max_by_column {
 
 class ZagryadskovMRunPerfTestMaxByColumn : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  InType input_data_;
-
   void SetUp() override {
     std::string in_file_name = "mat1.bin";
-    std::string abs_path =
-        ppc::util::GetAbsoluteTaskPath(PPC_ID_zagryadskov_m_max_by_column,
-                                       in_file_name);  // std::string abs_path = "../../data/mat1.bin";
-    std::ifstream in_file_stream(abs_path, std::ios::in | std::ios::binary);
-    if (!in_file_stream.is_open()) {
-      throw std::runtime_error("Error opening file!\n");
-    }
-    size_t m = 0;
-    size_t n = 0;
-    in_file_stream.read(reinterpret_cast<char *>(&m), sizeof(size_t));
-    in_file_stream.read(reinterpret_cast<char *>(&n), sizeof(size_t));
-    std::get<0>(input_data_) = n;
-    auto &mat = std::get<1>(input_data_);
-    mat.resize(m * n);
-    using T = std::decay_t<decltype(*mat.begin())>;
-
-    in_file_stream.read(reinterpret_cast<char *>(mat.data()), static_cast<std::streamsize>(sizeof(T) * m * n));
-
-    in_file_stream.close();
+    // Header of m and n followed by the n columns of m elements each
+    input_data_ = ppc::util::LazyMappedInput<double>(
+        ppc::util::GetAbsoluteTaskPath(PPC_ID_zagryadskov_m_max_by_column, in_file_name),
+        ppc::util::BinaryHeaderType::kUInt64, 2);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
     bool res = true;
-    size_t n = std::get<0>(input_data_);
-    size_t m = std::get<1>(input_data_).size() / n;
-    auto &mat = std::get<1>(input_data_);
+    const auto &mat = input_data_.Array();
+    size_t m = input_data_.Header().dims[0];
+    size_t n = input_data_.Header().dims[1];
     if (output_data.size() != n) {
       res = false;
       return res;
     }
 
-    using T = std::decay_t<decltype(*mat.begin())>;
+    using T = OutType::value_type;
     OutType example(n, std::numeric_limits<T>::lowest());
     for (size_t j = 0; j < n; ++j) {
       for (size_t i = 0; i < m; ++i) {
@@ -75,8 +56,11 @@ class ZagryadskovMRunPerfTestMaxByColumn : public ppc::util::BaseRunPerfTests<In
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    const auto &mat = input_data_.Array();
+    return {input_data_.Header().dims[1], std::vector<double>(mat.begin(), mat.end())};
   }
+
+  ppc::util::LazyMappedInput<double> input_data_;
 };
 
 TEST_P(ZagryadskovMRunPerfTestMaxByColumn, RunPerfModes) {
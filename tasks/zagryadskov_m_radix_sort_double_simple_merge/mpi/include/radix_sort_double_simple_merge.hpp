@@ -12,7 +12,10 @@ class ZagryadskovMRadixSortDoubleSimpleMergeMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit ZagryadskovMRadixSortDoubleSimpleMergeMPI(const InType &in);
+  static constexpr ppc::task::InputResidency GetStaticInputResidency() {
+    return ppc::task::InputResidency::kRootOnly;
+  }
+  explicit ZagryadskovMRadixSortDoubleSimpleMergeMPI(InType in);
 
  private:
   bool ValidationImpl() override;
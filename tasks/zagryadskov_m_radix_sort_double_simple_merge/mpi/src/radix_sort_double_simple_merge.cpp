@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "zagryadskov_m_radix_sort_double_simple_merge/common/include/common.hpp"
@@ -13,17 +14,9 @@
 
 namespace zagryadskov_m_radix_sort_double_simple_merge {
 
-ZagryadskovMRadixSortDoubleSimpleMergeMPI::ZagryadskovMRadixSortDoubleSimpleMergeMPI(const InType &in) {
+ZagryadskovMRadixSortDoubleSimpleMergeMPI::ZagryadskovMRadixSortDoubleSimpleMergeMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  int world_rank = 0;
-  int err_code = 0;
-  err_code = MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
-  if (err_code != MPI_SUCCESS) {
-    throw std::runtime_error("MPI_Comm_rank failed");
-  }
-  if (world_rank == 0) {
-    GetInput() = in;
-  }
+  GetInput() = std::move(in);
 }
 
 bool ZagryadskovMRadixSortDoubleSimpleMergeMPI::ValidationImpl() {
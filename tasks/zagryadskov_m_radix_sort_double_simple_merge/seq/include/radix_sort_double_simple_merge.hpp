@@ -14,7 +14,7 @@ class ZagryadskovMRadixSortDoubleSimpleMergeSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ZagryadskovMRadixSortDoubleSimpleMergeSEQ(const InType &in);
+  explicit ZagryadskovMRadixSortDoubleSimpleMergeSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
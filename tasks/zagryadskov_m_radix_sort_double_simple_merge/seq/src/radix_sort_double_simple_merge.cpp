@@ -12,9 +12,9 @@
 
 namespace zagryadskov_m_radix_sort_double_simple_merge {
 
-ZagryadskovMRadixSortDoubleSimpleMergeSEQ::ZagryadskovMRadixSortDoubleSimpleMergeSEQ(const InType &in) {
+ZagryadskovMRadixSortDoubleSimpleMergeSEQ::ZagryadskovMRadixSortDoubleSimpleMergeSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
 }
 
 bool ZagryadskovMRadixSortDoubleSimpleMergeSEQ::ValidationImpl() {
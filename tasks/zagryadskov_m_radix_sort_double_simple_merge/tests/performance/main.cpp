@@ -1,9 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
-#include <cmath>
+#include <bit>
 #include <cstddef>
-#include <limits>
+#include <cstdint>
 #include <random>
 #include <vector>
 
@@ -15,40 +15,56 @@
 namespace zagryadskov_m_radix_sort_double_simple_merge {
 
 class ZagryadskovMRunPerfTestRadixSortDoubleSimpleMerge : public ppc::util::BaseRunPerfTests<InType, OutType> {
-  InType input_data_;
-
   void SetUp() override {
-    TestType param = 10'000'123;
-    int seed = static_cast<int>(param % 100ULL);
-    std::mt19937 e(seed);
-    std::uniform_real_distribution<double> gen(-100000.0, 100000.0);
-    std::vector<double> &vec = input_data_;
-    vec.resize(param);
-    std::ranges::generate(vec.begin(), vec.end(), [&]() { return gen(e); });
+    param_ = 10'000'123;
   }
 
+  // Ranks other than 0 of the MPI task get no input, so the check regenerates the values one by one and compares
+  // a fingerprint that does not depend on their order instead of sorting a copy of the input
   bool CheckTestOutputData(OutType &output_data) final {
-    bool res = true;
-    std::vector<double> example = input_data_;
-    std::ranges::sort(example.begin(), example.end());
-    if (example.size() != output_data.size()) {
+    if (output_data.size() != param_ || !std::ranges::is_sorted(output_data)) {
       return false;
     }
-
-    for (size_t j = 0; j < example.size(); ++j) {
-      double diff = std::abs(example[j] - output_data[j]);
-      double eps = std::max(std::abs(example[j]), std::abs(output_data[j])) * std::numeric_limits<double>::epsilon();
-      if (diff > eps) {
-        res = false;
-      }
+    Fingerprint expected;
+    std::mt19937 e(Seed());
+    std::uniform_real_distribution<double> gen(-100000.0, 100000.0);
+    for (size_t j = 0; j < param_; ++j) {
+      expected.Add(gen(e));
     }
-
-    return res;
+    Fingerprint actual;
+    for (double value : output_data) {
+      actual.Add(value);
+    }
+    return actual == expected;
   }
 
   InType GetTestInputData() final {
-    return input_data_;
+    std::mt19937 e(Seed());
+    std::uniform_real_distribution<double> gen(-100000.0, 100000.0);
+    std::vector<double> vec(param_);
+    std::ranges::generate(vec.begin(), vec.end(), [&]() { return gen(e); });
+    return vec;
+  }
+
+  // Sums of the bit patterns and of their squares modulo 2^64
+  struct Fingerprint {
+    uint64_t sum = 0;
+    uint64_t sum_of_squares = 0;
+
+    void Add(double value) {
+      const auto bits = std::bit_cast<uint64_t>(value);
+      sum += bits;
+      sum_of_squares += bits * bits;
+    }
+
+    bool operator==(const Fingerprint &) const = default;
+  };
+
+  [[nodiscard]] int Seed() const {
+    return static_cast<int>(param_ % 100ULL);
   }
+
+  TestType param_ = 0;
 };
 
 TEST_P(ZagryadskovMRunPerfTestRadixSortDoubleSimpleMerge, RunPerfModes) {